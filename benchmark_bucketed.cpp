@@ -0,0 +1,127 @@
+/**
+ * BUCKETED LAYOUT
+ * ===============
+ * GroupedSIMDElastic (separate metadata and entry arrays) vs
+ * BucketedGroupedSIMD (control bytes and entries in one block) for
+ * uint64 -> uint64 and uint32 -> uint32, presized, at 1M-100M entries.
+ * Bucketed block counts are powers of two, so its load varies with n; the
+ * "same load" row sizes GroupedSIMDElastic to match it. Sizes can be given
+ * on the command line.
+ */
+
+#include "grouped_simd_elastic.hpp"
+#include "bucketed_grouped_simd.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+struct Times {
+    double insert, hit, miss;  // ns per op
+    double load;
+    size_t mb;
+};
+
+template <typename Table, typename K>
+Times measure(Table& table, const vector<K>& keys, const vector<K>& lookup_keys, const vector<K>& miss_keys) {
+    Times t;
+    auto start = high_resolution_clock::now();
+    for (size_t i = 0; i < keys.size(); ++i) table.insert(keys[i], static_cast<K>(i));
+    t.insert = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(keys.size());
+
+    const Table& view = table;
+    uint64_t sink = 0;
+    start = high_resolution_clock::now();
+    for (K k : lookup_keys) {
+        auto* v = view.find(k);
+        if (v) sink += *v;
+    }
+    t.hit = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(lookup_keys.size());
+
+    start = high_resolution_clock::now();
+    for (K k : miss_keys) {
+        auto* v = view.find(k);
+        if (v) sink += *v;
+    }
+    t.miss = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(miss_keys.size());
+
+    t.load = table.load_factor();
+    volatile uint64_t keep = sink;
+    (void)keep;
+    return t;
+}
+
+template <typename K>
+void compare(size_t n, const char* label) {
+    mt19937_64 rng(42);
+    vector<K> keys(n);
+    for (auto& k : keys) k = static_cast<K>(rng());
+    // 32-bit keys from a 64-bit generator can repeat; lookups still hit
+    vector<K> lookup_keys(n < 5000000 ? n : 5000000), miss_keys(lookup_keys.size());
+    for (auto& k : lookup_keys) k = keys[rng() % n];
+    for (auto& k : miss_keys) k = static_cast<K>(rng());
+
+    auto run_grouped = [&](size_t capacity) {
+        GroupedSIMDElastic<K, K> table(capacity);
+        Times t = measure(table, keys, lookup_keys, miss_keys);
+        t.mb = table.capacity() * (sizeof(K) * 2 + 1) >> 20;
+        return t;
+    };
+
+    BucketedGroupedSIMD<K, K> table(n);
+    Times bucketed = measure(table, keys, lookup_keys, miss_keys);
+    bucketed.mb = table.block_count() * BucketedGroupedSIMD<K, K>::BLOCK_BYTES >> 20;
+    size_t bucketed_capacity = table.capacity();
+    table = BucketedGroupedSIMD<K, K>(1);  // Release before the next run
+
+    Times grouped = run_grouped(static_cast<size_t>(n / 0.85));
+    Times same_load = run_grouped(bucketed_capacity);
+
+    auto row = [](const string& name, const Times& t) {
+        cout << left << setw(22) << name
+             << right << setw(10) << fixed << setprecision(1) << t.insert
+             << setw(10) << t.hit
+             << setw(10) << t.miss
+             << setw(10) << setprecision(2) << t.load
+             << setw(10) << t.mb << "\n";
+    };
+    row(string(label) + " " + to_string(n), grouped);
+    row("  same load", same_load);
+    row("  bucketed", bucketed);
+    cout << left << setw(22) << "  same load/bucketed"
+         << right << setw(9) << setprecision(2) << same_load.insert / bucketed.insert << "x"
+         << setw(9) << same_load.hit / bucketed.hit << "x"
+         << setw(9) << same_load.miss / bucketed.miss << "x\n";
+}
+
+int main(int argc, char** argv) {
+    cout << "============================================================\n";
+    cout << "  BUCKETED LAYOUT: GroupedSIMD vs BucketedGroupedSIMD\n";
+    cout << "============================================================\n\n";
+
+    vector<size_t> sizes = {1000000, 10000000, 100000000};
+    if (argc > 1) {
+        sizes.clear();
+        for (int i = 1; i < argc; ++i) sizes.push_back(stoull(argv[i]));
+    }
+
+    cout << left << setw(22) << "ns/op"
+         << right << setw(10) << "insert"
+         << setw(10) << "hit"
+         << setw(10) << "miss"
+         << setw(10) << "load"
+         << setw(10) << "MB" << "\n";
+    cout << string(72, '-') << "\n";
+
+    for (size_t n : sizes) {
+        compare<uint64_t>(n, "u64");
+        compare<uint32_t>(n, "u32");
+    }
+    return 0;
+}
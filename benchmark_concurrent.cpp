@@ -0,0 +1,230 @@
+/**
+ * CONCURRENT THROUGHPUT
+ * =====================
+ * ShardedGroupedSIMD vs one GroupedSIMDElastic behind a global mutex,
+ * 1 to 64 threads, mixed lookups and inserts over a prefilled table;
+ * insert-only ingest adds ConcurrentGroupedSIMD (lock-free CAS inserts),
+ * presized and grown from 64K slots by cooperative resizes,
+ * read-mostly adds SeqlockGroupedSIMD (optimistic lock-free readers)
+ */
+
+#include "sharded_grouped_simd.hpp"
+#include "concurrent_grouped_simd.hpp"
+#include "seqlock_grouped_simd.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+// One GroupedSIMDElastic, every operation serialized: what callers do today
+class GlobalLockTable {
+    GroupedSIMDElastic<uint64_t, uint64_t> table_;
+    mutable mutex lock_;
+
+public:
+    explicit GlobalLockTable(size_t capacity) : table_(capacity) {}
+
+    void insert(uint64_t key, uint64_t value) {
+        lock_guard<mutex> guard(lock_);
+        table_.insert(key, value);
+    }
+
+    bool try_emplace(uint64_t key, uint64_t value) {
+        lock_guard<mutex> guard(lock_);
+        return table_.try_emplace(key, value).second;
+    }
+
+    bool find(uint64_t key, uint64_t& out) const {
+        lock_guard<mutex> guard(lock_);
+        const uint64_t* v = table_.find(key);
+        if (!v) return false;
+        out = *v;
+        return true;
+    }
+};
+
+// Total ops are split evenly across threads; returns million ops per second
+template <typename Table>
+double run_mixed(Table& table, const vector<uint64_t>& keys, size_t threads,
+                 size_t total_ops, unsigned insert_percent) {
+    size_t ops_per_thread = total_ops / threads;
+    vector<thread> workers;
+    auto start = high_resolution_clock::now();
+
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            mt19937_64 rng(1000 + t);
+            uint64_t sink = 0;
+            for (size_t i = 0; i < ops_per_thread; ++i) {
+                uint64_t r = rng();
+                uint64_t key = keys[r % keys.size()];
+                if ((r >> 32) % 100 < insert_percent) {
+                    table.insert(key ^ (r >> 40), i);  // Mostly new keys
+                } else {
+                    uint64_t v;
+                    if (table.find(key, v)) sink += v;
+                }
+            }
+            volatile uint64_t keep = sink;
+            (void)keep;
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    double secs = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+    return ops_per_thread * threads / secs / 1e6;
+}
+
+// Insert-if-absent from every thread; hot_percent of the ops go to the first
+// 1% of the keys. Returns million inserts per second.
+template <typename InsertFn>
+double run_ingest(InsertFn&& insert, const vector<uint64_t>& keys, size_t threads,
+                  unsigned hot_percent) {
+    size_t ops_per_thread = keys.size() / threads;
+    size_t hot_keys = keys.size() / 100;
+    vector<thread> workers;
+    auto start = high_resolution_clock::now();
+
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            mt19937_64 rng(2000 + t);
+            for (size_t i = 0; i < ops_per_thread; ++i) {
+                uint64_t r = rng();
+                bool hot = (r >> 32) % 100 < hot_percent;
+                insert(keys[hot ? r % hot_keys : r % keys.size()], i);
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    double secs = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+    return ops_per_thread * threads / secs / 1e6;
+}
+
+int main() {
+    cout << "============================================================\n";
+    cout << "  CONCURRENT THROUGHPUT: sharded vs global mutex\n";
+    cout << "============================================================\n\n";
+
+    const size_t n = 1000000;
+    const size_t total_ops = 8000000;
+    const size_t shards = 256;
+    vector<size_t> thread_counts = {1, 2, 4, 8, 16, 32, 64};
+
+    cout << "Hardware threads: " << thread::hardware_concurrency()
+         << ", prefilled keys: " << n << ", ops per run: " << total_ops
+         << ", shards: " << shards << "\n";
+
+    mt19937_64 rng(42);
+    vector<uint64_t> keys(n);
+    for (auto& k : keys) k = rng();
+
+    for (unsigned insert_percent : {10u, 50u}) {
+        cout << "\n" << (100 - insert_percent) << "% find / " << insert_percent << "% insert (Mops/s)\n";
+        cout << left << setw(10) << "Threads"
+             << right << setw(14) << "Global lock"
+             << setw(14) << "Sharded"
+             << setw(12) << "Speedup" << "\n";
+        cout << string(50, '-') << "\n";
+
+        for (size_t threads : thread_counts) {
+            // Room for the prefill plus every insert, so no run measures a resize
+            size_t capacity = static_cast<size_t>((n + total_ops * insert_percent / 100) / 0.85);
+
+            GlobalLockTable global(capacity);
+            ShardedGroupedSIMD<uint64_t, uint64_t> sharded(capacity, shards);
+            for (size_t i = 0; i < n; ++i) {
+                global.insert(keys[i], i);
+                sharded.insert(keys[i], i);
+            }
+
+            double global_mops = run_mixed(global, keys, threads, total_ops, insert_percent);
+            double sharded_mops = run_mixed(sharded, keys, threads, total_ops, insert_percent);
+
+            cout << left << setw(10) << threads
+                 << right << setw(14) << fixed << setprecision(2) << global_mops
+                 << setw(14) << sharded_mops
+                 << setw(11) << sharded_mops / global_mops << "x\n";
+        }
+    }
+
+    cout << "\nRead-mostly, 99% find / 1% insert (Mops/s)\n";
+    cout << left << setw(10) << "Threads"
+         << right << setw(14) << "Global lock"
+         << setw(14) << "Sharded"
+         << setw(14) << "Seqlock"
+         << setw(12) << "SL/global" << "\n";
+    cout << string(64, '-') << "\n";
+
+    for (size_t threads : thread_counts) {
+        size_t capacity = static_cast<size_t>((n + total_ops / 100) / 0.85);
+
+        GlobalLockTable global(capacity);
+        ShardedGroupedSIMD<uint64_t, uint64_t> sharded(capacity, shards);
+        SeqlockGroupedSIMD<uint64_t, uint64_t> seqlock(capacity);
+        for (size_t i = 0; i < n; ++i) {
+            global.insert(keys[i], i);
+            sharded.insert(keys[i], i);
+            seqlock.insert(keys[i], i);
+        }
+
+        double global_mops = run_mixed(global, keys, threads, total_ops, 1);
+        double sharded_mops = run_mixed(sharded, keys, threads, total_ops, 1);
+        double seqlock_mops = run_mixed(seqlock, keys, threads, total_ops, 1);
+
+        cout << left << setw(10) << threads
+             << right << setw(14) << fixed << setprecision(2) << global_mops
+             << setw(14) << sharded_mops
+             << setw(14) << seqlock_mops
+             << setw(11) << seqlock_mops / global_mops << "x\n";
+    }
+
+    const size_t ingest_n = 4000000;
+    vector<uint64_t> ingest_keys(ingest_n);
+    for (auto& k : ingest_keys) k = rng();
+    size_t ingest_capacity = static_cast<size_t>(ingest_n / 0.85);
+
+    for (unsigned hot_percent : {0u, 90u}) {
+        cout << "\nIngest, " << (hot_percent ? "90% of inserts on 1% of keys" : "uniform keys")
+             << " (M inserts/s)\n";
+        cout << left << setw(10) << "Threads"
+             << right << setw(14) << "Global lock"
+             << setw(14) << "Sharded"
+             << setw(14) << "Lock-free"
+             << setw(14) << "LF growing"
+             << setw(12) << "LF/global" << "\n";
+        cout << string(78, '-') << "\n";
+
+        for (size_t threads : thread_counts) {
+            GlobalLockTable global(ingest_capacity);
+            ShardedGroupedSIMD<uint64_t, uint64_t> sharded(ingest_capacity, shards);
+            ConcurrentGroupedSIMD<uint64_t, uint64_t> lock_free(ingest_capacity);
+            ConcurrentGroupedSIMD<uint64_t, uint64_t> growing(1 << 16);  // Six doublings
+
+            double global_mops = run_ingest(
+                [&](uint64_t k, uint64_t v) { global.try_emplace(k, v); }, ingest_keys, threads, hot_percent);
+            double sharded_mops = run_ingest(
+                [&](uint64_t k, uint64_t v) { sharded.try_emplace(k, v); }, ingest_keys, threads, hot_percent);
+            double lock_free_mops = run_ingest(
+                [&](uint64_t k, uint64_t v) { lock_free.insert(k, v); }, ingest_keys, threads, hot_percent);
+            double growing_mops = run_ingest(
+                [&](uint64_t k, uint64_t v) { growing.insert(k, v); }, ingest_keys, threads, hot_percent);
+
+            cout << left << setw(10) << threads
+                 << right << setw(14) << fixed << setprecision(2) << global_mops
+                 << setw(14) << sharded_mops
+                 << setw(14) << lock_free_mops
+                 << setw(14) << growing_mops
+                 << setw(11) << lock_free_mops / global_mops << "x\n";
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+/**
+ * DIRECT KEYS
+ * ===========
+ * uint32 -> uint32, presized, at 1M-100M entries: GroupedSIMDElastic
+ * (metadata bytes + entries), BucketedGroupedSIMD (control bytes and entries
+ * in one block) and DirectKeyGroupedSIMD (keys scanned directly, no
+ * metadata). GroupedSIMDElastic is sized to the load DirectKeyGroupedSIMD
+ * ends up at. Sizes can be given on the command line.
+ */
+
+#include "grouped_simd_elastic.hpp"
+#include "bucketed_grouped_simd.hpp"
+#include "direct_key_grouped_simd.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+struct Times {
+    double insert, hit, miss;  // ns per op
+    double load;
+    size_t mb;
+};
+
+template <typename Table>
+Times measure(Table& table, const vector<uint32_t>& keys, const vector<uint32_t>& lookup_keys,
+              const vector<uint32_t>& miss_keys) {
+    Times t;
+    auto start = high_resolution_clock::now();
+    for (size_t i = 0; i < keys.size(); ++i) table.insert(keys[i], static_cast<uint32_t>(i));
+    t.insert = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(keys.size());
+
+    const Table& view = table;
+    uint64_t sink = 0;
+    start = high_resolution_clock::now();
+    for (uint32_t k : lookup_keys) {
+        auto* v = view.find(k);
+        if (v) sink += *v;
+    }
+    t.hit = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(lookup_keys.size());
+
+    start = high_resolution_clock::now();
+    for (uint32_t k : miss_keys) {
+        auto* v = view.find(k);
+        if (v) sink += *v;
+    }
+    t.miss = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(miss_keys.size());
+
+    t.load = table.load_factor();
+    volatile uint64_t keep = sink;
+    (void)keep;
+    return t;
+}
+
+void compare(size_t n) {
+    // Distinct keys below the reserved UINT32_MAX - 1 and UINT32_MAX; misses
+    // come from the upper half of the key space
+    mt19937_64 rng(42);
+    vector<uint32_t> keys(n);
+    for (size_t i = 0; i < n; ++i) keys[i] = static_cast<uint32_t>(i * 2654435761ULL % 0x80000000ULL);
+    vector<uint32_t> lookup_keys(n < 5000000 ? n : 5000000), miss_keys(lookup_keys.size());
+    for (auto& k : lookup_keys) k = keys[rng() % n];
+    for (auto& k : miss_keys) k = static_cast<uint32_t>(0x80000000ULL + rng() % 0x7FFFFFF0ULL);
+
+    Times direct, bucketed, grouped;
+    size_t direct_capacity;
+    {
+        DirectKeyGroupedSIMD<uint32_t> table(n);
+        direct = measure(table, keys, lookup_keys, miss_keys);
+        direct.mb = table.capacity() * (sizeof(uint32_t) * 2) >> 20;
+        direct_capacity = table.capacity();
+    }
+    {
+        BucketedGroupedSIMD<uint32_t, uint32_t> table(n);
+        bucketed = measure(table, keys, lookup_keys, miss_keys);
+        bucketed.mb = table.block_count() * BucketedGroupedSIMD<uint32_t, uint32_t>::BLOCK_BYTES >> 20;
+    }
+    {
+        GroupedSIMDElastic<uint32_t, uint32_t> table(direct_capacity);
+        grouped = measure(table, keys, lookup_keys, miss_keys);
+        grouped.mb = table.capacity() * (sizeof(uint32_t) * 2 + 1) >> 20;
+    }
+
+    auto row = [](const string& name, const Times& t) {
+        cout << left << setw(22) << name
+             << right << setw(10) << fixed << setprecision(1) << t.insert
+             << setw(10) << t.hit
+             << setw(10) << t.miss
+             << setw(10) << setprecision(2) << t.load
+             << setw(10) << t.mb << "\n";
+    };
+    row("u32 " + to_string(n), grouped);
+    row("  bucketed", bucketed);
+    row("  direct key", direct);
+    cout << left << setw(22) << "  grouped/direct"
+         << right << setw(9) << setprecision(2) << grouped.insert / direct.insert << "x"
+         << setw(9) << grouped.hit / direct.hit << "x"
+         << setw(9) << grouped.miss / direct.miss << "x\n";
+}
+
+int main(int argc, char** argv) {
+    cout << "============================================================\n";
+    cout << "  DIRECT KEYS: metadata vs blocks vs direct key scan (u32)\n";
+    cout << "============================================================\n\n";
+
+    vector<size_t> sizes = {1000000, 10000000, 100000000};
+    if (argc > 1) {
+        sizes.clear();
+        for (int i = 1; i < argc; ++i) sizes.push_back(stoull(argv[i]));
+    }
+
+    cout << left << setw(22) << "ns/op"
+         << right << setw(10) << "insert"
+         << setw(10) << "hit"
+         << setw(10) << "miss"
+         << setw(10) << "load"
+         << setw(10) << "MB" << "\n";
+    cout << string(72, '-') << "\n";
+
+    for (size_t n : sizes) compare(n);
+    return 0;
+}
@@ -5,13 +5,16 @@
  */
 
 #include "grouped_simd_elastic.hpp"
+#include "mapped_grouped_simd.hpp"
 #include "hybrid_elastic.hpp"
 #include "ankerl_unordered_dense.h"
 
 #include <iostream>
 #include <iomanip>
 #include <chrono>
+#include <cstdio>
 #include <random>
+#include <thread>
 #include <vector>
 
 using namespace std;
@@ -25,6 +28,41 @@ double time_ms(Func&& func) {
     return duration_cast<microseconds>(end - start).count() / 1000.0;
 }
 
+// std::hash as is, marked avalanching so the table skips its mixer: what the
+// table did before it mixed hashes itself
+struct RawStdHash {
+    using is_avalanching = void;
+    size_t operator()(uint64_t k) const { return std::hash<uint64_t>{}(k); }
+};
+
+struct OpTimes {
+    double insert, hit, miss;
+    double total() const { return insert + hit + miss; }
+};
+
+// Insert all keys into a GroupedSIMDElastic at 85% load, then time hits and misses
+template <typename Hash = std::hash<uint64_t>>
+OpTimes time_grouped(GroupBackend backend, const vector<uint64_t>& keys,
+                     const vector<uint64_t>& lookup_keys, const vector<uint64_t>& miss_keys) {
+    size_t n = keys.size();
+    size_t capacity = static_cast<size_t>(n / 0.85);
+    GroupedSIMDElastic<uint64_t, uint64_t, Hash> table(capacity, 0.1, false, backend);
+    OpTimes t;
+
+    t.insert = time_ms([&]() {
+        for (size_t i = 0; i < n; ++i) table.insert(keys[i], i);
+    });
+
+    volatile uint64_t sink = 0;
+    t.hit = time_ms([&]() {
+        for (auto k : lookup_keys) { auto* p = table.find(k); if (p) sink += *p; }
+    });
+    t.miss = time_ms([&]() {
+        for (auto k : miss_keys) { auto* p = table.find(k); if (p) sink += *p; }
+    });
+    return t;
+}
+
 int main() {
     cout << "============================================================\n";
     cout << "  FINAL SOTA COMPARISON: GroupedSIMD vs ankerl\n";
@@ -226,5 +264,242 @@ int main() {
     }
     cout << "============================================================\n";
 
+    cout << "\n============================================================\n";
+    cout << "  GROUP BACKENDS (gain vs SSE2 per table size)\n";
+    cout << "============================================================\n\n";
+
+    // Selected at runtime: one binary covers every host
+    vector<pair<const char*, GroupBackend>> backends = {{"SSE2", GroupBackend::SSE2},
+                                                        {"SWAR", GroupBackend::SWAR}};
+    if (group_backend_supported(GroupBackend::AVX2)) {
+        backends.push_back({"AVX2", GroupBackend::AVX2});
+    }
+    if (group_backend_supported(GroupBackend::AVX512)) {
+        backends.push_back({"AVX-512", GroupBackend::AVX512});
+    }
+
+    cout << left << setw(10) << "Size"
+         << setw(10) << "Backend"
+         << right << setw(12) << "Insert"
+         << setw(12) << "Hit"
+         << setw(12) << "Miss"
+         << setw(12) << "Miss gain"
+         << setw(12) << "Total gain" << "\n";
+    cout << string(80, '-') << "\n";
+
+    for (size_t bn : sizes) {
+        mt19937_64 brng(42);
+        vector<uint64_t> bkeys(bn);
+        for (auto& k : bkeys) k = brng();
+
+        vector<uint64_t> blookup(bkeys.begin(), bkeys.begin() + bn/10);
+        shuffle(blookup.begin(), blookup.end(), brng);
+
+        vector<uint64_t> bmiss(bn/10);
+        for (auto& k : bmiss) k = brng();
+
+        OpTimes sse2{};
+        for (auto& [name, backend] : backends) {
+            OpTimes t = time_grouped(backend, bkeys, blookup, bmiss);
+            if (backend == GroupBackend::SSE2) sse2 = t;
+
+            cout << left << setw(10) << bn
+                 << setw(10) << name
+                 << right << setw(12) << fixed << setprecision(2) << t.insert
+                 << setw(12) << t.hit
+                 << setw(12) << t.miss
+                 << setw(12) << sse2.miss / t.miss << "x"
+                 << setw(11) << sse2.total() / t.total() << "x\n";
+        }
+    }
+
+    cout << "\n============================================================\n";
+    cout << "  BATCHED LOOKUPS: find() loop vs find_many()\n";
+    cout << "============================================================\n\n";
+
+    cout << left << setw(10) << "Size"
+         << right << setw(12) << "find hit"
+         << setw(12) << "many hit"
+         << setw(12) << "Speedup"
+         << setw(12) << "find miss"
+         << setw(12) << "many miss"
+         << setw(12) << "Speedup" << "\n";
+    cout << string(82, '-') << "\n";
+
+    for (size_t bn : sizes) {
+        mt19937_64 brng(42);
+        vector<uint64_t> bkeys(bn);
+        for (auto& k : bkeys) k = brng();
+
+        vector<uint64_t> blookup(bkeys.begin(), bkeys.begin() + bn/10);
+        shuffle(blookup.begin(), blookup.end(), brng);
+
+        vector<uint64_t> bmiss(bn/10);
+        for (auto& k : bmiss) k = brng();
+
+        GroupedSIMDElastic<uint64_t, uint64_t> table(static_cast<size_t>(bn / 0.85));
+        for (size_t i = 0; i < bn; ++i) table.insert(bkeys[i], i);
+
+        vector<uint64_t*> results(blookup.size());
+        volatile uint64_t bsink = 0;
+
+        double find_hit = time_ms([&]() {
+            for (auto k : blookup) { auto* p = table.find(k); if (p) bsink += *p; }
+        });
+        double many_hit = time_ms([&]() {
+            table.find_many(blookup.data(), blookup.size(), results.data());
+            for (auto* p : results) if (p) bsink += *p;
+        });
+        double find_miss = time_ms([&]() {
+            for (auto k : bmiss) { auto* p = table.find(k); if (p) bsink += *p; }
+        });
+        double many_miss = time_ms([&]() {
+            table.find_many(bmiss.data(), bmiss.size(), results.data());
+            for (auto* p : results) if (p) bsink += *p;
+        });
+
+        cout << left << setw(10) << bn
+             << right << setw(12) << fixed << setprecision(2) << find_hit
+             << setw(12) << many_hit
+             << setw(11) << find_hit / many_hit << "x"
+             << setw(12) << find_miss
+             << setw(12) << many_miss
+             << setw(11) << find_miss / many_miss << "x\n";
+    }
+
+    cout << "\n============================================================\n";
+    cout << "  BULK LOAD: insert() loop vs insert_many() vs build()\n";
+    cout << "============================================================\n\n";
+
+    size_t build_threads = max(1u, thread::hardware_concurrency());
+    cout << "build(N): " << build_threads << " threads\n\n";
+    cout << left << setw(10) << "Size"
+         << right << setw(12) << "insert"
+         << setw(14) << "insert_many"
+         << setw(12) << "build(1)"
+         << setw(12) << "build(N)"
+         << setw(12) << "Speedup" << "\n";
+    cout << string(72, '-') << "\n";
+
+    for (size_t bn : sizes) {
+        mt19937_64 brng(42);
+        vector<uint64_t> bkeys(bn), bvalues(bn);
+        for (size_t i = 0; i < bn; ++i) { bkeys[i] = brng(); bvalues[i] = i; }
+
+        // All presized at 85% load, as in the comparison above
+        size_t bcapacity = static_cast<size_t>(bn / 0.85);
+
+        double insert_loop;
+        {
+            GroupedSIMDElastic<uint64_t, uint64_t> table(bcapacity);
+            insert_loop = time_ms([&]() {
+                for (size_t i = 0; i < bn; ++i) table.insert(bkeys[i], bvalues[i]);
+            });
+        }
+
+        double insert_many;
+        {
+            GroupedSIMDElastic<uint64_t, uint64_t> table(bcapacity);
+            insert_many = time_ms([&]() {
+                table.insert_many(bkeys.data(), bvalues.data(), bn);
+            });
+        }
+
+        double build_one = time_ms([&]() {
+            auto table = GroupedSIMDElastic<uint64_t, uint64_t>::build(bkeys.data(), bvalues.data(), bn, 1, 0.15);
+        });
+        double build_all = time_ms([&]() {
+            auto table = GroupedSIMDElastic<uint64_t, uint64_t>::build(bkeys.data(), bvalues.data(), bn,
+                                                                        build_threads, 0.15);
+        });
+
+        cout << left << setw(10) << bn
+             << right << setw(12) << fixed << setprecision(2) << insert_loop
+             << setw(14) << insert_many
+             << setw(12) << build_one
+             << setw(12) << build_all
+             << setw(11) << insert_loop / build_all << "x\n";
+    }
+
+    cout << "\n============================================================\n";
+    cout << "  COLD START: build() vs mapping a saved table (100K lookups)\n";
+    cout << "============================================================\n\n";
+
+    // The file was just written, so it is in the page cache: this measures
+    // mapping and page-fault cost, not disk reads
+    const char* saved_path = "grouped_simd_bench.tbl";
+    const size_t cold_lookups = 100000;
+    cout << left << setw(10) << "Size"
+         << right << setw(12) << "build"
+         << setw(12) << "mmap"
+         << setw(14) << "mmap+pop"
+         << setw(12) << "Speedup" << "\n";
+    cout << string(60, '-') << "\n";
+
+    for (size_t cn : sizes) {
+        mt19937_64 crng(42);
+        vector<uint64_t> ckeys(cn), cvalues(cn);
+        for (size_t i = 0; i < cn; ++i) { ckeys[i] = crng(); cvalues[i] = i; }
+
+        GroupedSIMDElastic<uint64_t, uint64_t>::build(ckeys.data(), cvalues.data(), cn, 1, 0.15).save(saved_path);
+
+        uint64_t cold_sink = 0;
+        double rebuild = time_ms([&]() {
+            auto table = GroupedSIMDElastic<uint64_t, uint64_t>::build(ckeys.data(), cvalues.data(), cn, 1, 0.15);
+            const auto& view = table;
+            for (size_t i = 0; i < cold_lookups; ++i) cold_sink += *view.find(ckeys[(i * 7919) % cn]);
+        });
+        double mapped = time_ms([&]() {
+            MappedGroupedSIMD<uint64_t, uint64_t> view(saved_path);
+            for (size_t i = 0; i < cold_lookups; ++i) cold_sink += *view.find(ckeys[(i * 7919) % cn]);
+        });
+        double populated = time_ms([&]() {
+            MappedGroupedSIMD<uint64_t, uint64_t> view(saved_path, true);
+            for (size_t i = 0; i < cold_lookups; ++i) cold_sink += *view.find(ckeys[(i * 7919) % cn]);
+        });
+        volatile uint64_t keep = cold_sink;
+        (void)keep;
+
+        cout << left << setw(10) << cn
+             << right << setw(12) << fixed << setprecision(2) << rebuild
+             << setw(12) << mapped
+             << setw(14) << populated
+             << setw(11) << rebuild / mapped << "x\n";
+    }
+    remove(saved_path);
+
+    cout << "\n============================================================\n";
+    cout << "  KEY PATTERNS: raw std::hash vs built-in mixer (1M keys)\n";
+    cout << "============================================================\n\n";
+
+    cout << left << setw(12) << "Pattern"
+         << right << setw(12) << "raw total"
+         << setw(12) << "mixed total"
+         << setw(12) << "Speedup" << "\n";
+    cout << string(48, '-') << "\n";
+
+    const size_t pn = 1000000;
+    const char* pattern_names[] = {"random", "sequential", "stride 4096"};
+    for (int pattern = 0; pattern < 3; ++pattern) {
+        mt19937_64 prng(42);
+        vector<uint64_t> pkeys(pn), pmiss(pn / 10);
+        for (size_t i = 0; i < pn; ++i) {
+            pkeys[i] = pattern == 0 ? prng() : pattern == 1 ? i : i * 4096;
+        }
+        for (size_t i = 0; i < pmiss.size(); ++i) {
+            pmiss[i] = pattern == 0 ? prng() : pattern == 1 ? pn + i : (pn + i) * 4096;
+        }
+        vector<uint64_t> plookup(pkeys.begin(), pkeys.begin() + pn / 10);
+        shuffle(plookup.begin(), plookup.end(), prng);
+
+        double raw = time_grouped<RawStdHash>(GroupBackend::Auto, pkeys, plookup, pmiss).total();
+        double mixed = time_grouped(GroupBackend::Auto, pkeys, plookup, pmiss).total();
+
+        cout << left << setw(12) << pattern_names[pattern]
+             << right << setw(12) << fixed << setprecision(2) << raw
+             << setw(12) << mixed
+             << setw(11) << raw / mixed << "x\n";
+    }
+
     return 0;
 }
@@ -0,0 +1,141 @@
+/**
+ * HUGE PAGES
+ * ==========
+ * Lookup latency of GroupedSIMDElastic with the default allocator vs
+ * HugePageAllocator (2MB pages) at 10M-100M entries, where random probes
+ * miss the TLB on 4KB pages. Sizes can be given on the command line.
+ */
+
+#include "grouped_simd_elastic.hpp"
+#include "huge_page_allocator.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+struct Latency {
+    double hit, miss, chain;  // ns per lookup
+};
+
+// kB of the current process's memory on huge pages (transparent or hugetlb)
+size_t huge_page_kb() {
+    ifstream smaps("/proc/self/smaps_rollup");
+    string line;
+    size_t total = 0;
+    while (getline(smaps, line)) {
+        if (line.rfind("AnonHugePages:", 0) == 0 || line.rfind("Private_Hugetlb:", 0) == 0) {
+            total += stoull(line.substr(line.find(':') + 1));
+        }
+    }
+    return total;
+}
+
+// hit: independent random lookups, which the CPU overlaps. chain: each key
+// comes from the previous lookup's value, so misses cannot overlap and the
+// time per lookup is the full memory and page-walk latency.
+template <typename Allocator>
+Latency measure(const vector<uint64_t>& keys, const vector<uint64_t>& next,
+                const vector<uint64_t>& miss_keys, size_t lookups, size_t threads, size_t& huge_kb) {
+    size_t n = keys.size();
+    using Table = GroupedSIMDElastic<uint64_t, uint64_t, hash<uint64_t>, equal_to<uint64_t>, Allocator>;
+    const Table table = Table::build(keys.data(), next.data(), n, threads, 0.15);
+    huge_kb = huge_page_kb();
+
+    mt19937_64 rng(7);
+    vector<uint64_t> probe(lookups);
+    for (auto& k : probe) k = keys[rng() % n];
+
+    Latency l;
+    uint64_t sink = 0;
+    auto start = high_resolution_clock::now();
+    for (uint64_t k : probe) sink += *table.find(k);
+    l.hit = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(lookups);
+
+    start = high_resolution_clock::now();
+    for (size_t i = 0; i < lookups; ++i) {
+        const uint64_t* v = table.find(miss_keys[i % miss_keys.size()]);
+        if (v) sink += *v;
+    }
+    l.miss = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(lookups);
+
+    uint64_t idx = 0;
+    start = high_resolution_clock::now();
+    for (size_t i = 0; i < lookups; ++i) idx = *table.find(keys[idx]);
+    l.chain = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(lookups);
+
+    volatile uint64_t keep = sink + idx;
+    (void)keep;
+    return l;
+}
+
+int main(int argc, char** argv) {
+    cout << "============================================================\n";
+    cout << "  HUGE PAGES: std::allocator vs HugePageAllocator\n";
+    cout << "============================================================\n\n";
+
+    vector<size_t> sizes = {10000000, 30000000, 100000000};
+    if (argc > 1) {
+        sizes.clear();
+        for (int i = 1; i < argc; ++i) sizes.push_back(stoull(argv[i]));
+    }
+    const size_t lookups = 5000000;
+    size_t threads = max(1u, thread::hardware_concurrency());
+
+    ifstream thp("/sys/kernel/mm/transparent_hugepage/enabled");
+    string thp_mode;
+    getline(thp, thp_mode);
+    cout << "THP: " << (thp_mode.empty() ? "n/a" : thp_mode) << ", lookups per run: " << lookups
+         << ", load 85%\n";
+    cout << "hit/miss: independent lookups; chain: each key from the previous value (ns/lookup)\n\n";
+
+    cout << left << setw(11) << "Size"
+         << setw(10) << "Pages"
+         << right << setw(10) << "hit"
+         << setw(10) << "miss"
+         << setw(10) << "chain"
+         << setw(14) << "Huge MB" << "\n";
+    cout << string(65, '-') << "\n";
+
+    for (size_t n : sizes) {
+        mt19937_64 rng(42);
+        vector<uint64_t> keys(n), next(n), miss_keys(1 << 20);
+        for (auto& k : keys) k = rng();
+        for (auto& k : miss_keys) k = rng();
+
+        // One random cycle through all keys: the value of keys[i] is the
+        // index of the key to look up next
+        vector<uint64_t> order(n);
+        for (size_t i = 0; i < n; ++i) order[i] = i;
+        shuffle(order.begin(), order.end(), rng);
+        for (size_t i = 0; i < n; ++i) next[order[i]] = order[(i + 1) % n];
+
+        size_t small_kb, huge_kb;
+        Latency small = measure<allocator<uint8_t>>(keys, next, miss_keys, lookups, threads, small_kb);
+        Latency huge = measure<HugePageAllocator<uint8_t>>(keys, next, miss_keys, lookups, threads, huge_kb);
+
+        cout << left << setw(11) << n << setw(10) << "4KB"
+             << right << setw(10) << fixed << setprecision(1) << small.hit
+             << setw(10) << small.miss
+             << setw(10) << small.chain
+             << setw(14) << small_kb / 1024 << "\n";
+        cout << left << setw(11) << "" << setw(10) << "2MB"
+             << right << setw(10) << huge.hit
+             << setw(10) << huge.miss
+             << setw(10) << huge.chain
+             << setw(14) << huge_kb / 1024 << "\n";
+        cout << left << setw(11) << "" << setw(10) << "Speedup"
+             << right << setw(9) << setprecision(2) << small.hit / huge.hit << "x"
+             << setw(9) << small.miss / huge.miss << "x"
+             << setw(9) << small.chain / huge.chain << "x\n";
+    }
+
+    return 0;
+}
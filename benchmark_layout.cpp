@@ -0,0 +1,119 @@
+/**
+ * ENTRY LAYOUT
+ * ============
+ * EntryLayout::AoS vs EntryLayout::SoA with 8, 32 and 128-byte values:
+ * insert, hit and miss time at 85% load. Misses and false fragment matches
+ * read only keys in SoA; hits read the value in a second line.
+ * EntryLayout::SoASIMDKeys is SoA with the candidate keys of a fragment
+ * match compared by SSE2/AVX2 instead of one at a time.
+ */
+
+#include "grouped_simd_elastic.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+template <size_t Bytes>
+struct Value {
+    uint64_t words[Bytes / 8];
+};
+
+struct Times {
+    double insert, hit, miss;  // ns per op
+};
+
+template <EntryLayout Layout, size_t Bytes>
+Times measure(const vector<uint64_t>& keys, const vector<uint64_t>& lookup_keys,
+              const vector<uint64_t>& miss_keys) {
+    using Table = GroupedSIMDElastic<uint64_t, Value<Bytes>, hash<uint64_t>, equal_to<uint64_t>,
+                                     allocator<uint8_t>, Layout>;
+    size_t n = keys.size();
+    Table table(static_cast<size_t>(n / 0.85));
+    Times t;
+
+    auto start = high_resolution_clock::now();
+    for (size_t i = 0; i < n; ++i) table.insert(keys[i], Value<Bytes>{{i}});
+    t.insert = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(n);
+
+    const Table& view = table;
+    uint64_t sink = 0;
+    start = high_resolution_clock::now();
+    for (uint64_t k : lookup_keys) {
+        const Value<Bytes>* v = view.find(k);
+        if (v) sink += v->words[0];
+    }
+    t.hit = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(lookup_keys.size());
+
+    start = high_resolution_clock::now();
+    for (uint64_t k : miss_keys) {
+        const Value<Bytes>* v = view.find(k);
+        if (v) sink += v->words[0];
+    }
+    t.miss = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(miss_keys.size());
+
+    volatile uint64_t keep = sink;
+    (void)keep;
+    return t;
+}
+
+template <size_t Bytes>
+void compare(const vector<uint64_t>& keys, const vector<uint64_t>& lookup_keys,
+             const vector<uint64_t>& miss_keys) {
+    Times aos = measure<EntryLayout::AoS, Bytes>(keys, lookup_keys, miss_keys);
+    Times soa = measure<EntryLayout::SoA, Bytes>(keys, lookup_keys, miss_keys);
+    Times simd = measure<EntryLayout::SoASIMDKeys, Bytes>(keys, lookup_keys, miss_keys);
+
+    auto row = [](const char* name, const Times& t) {
+        cout << left << setw(8) << "" << setw(8) << name
+             << right << setw(10) << fixed << setprecision(1) << t.insert
+             << setw(10) << t.hit
+             << setw(10) << t.miss << "\n";
+    };
+    auto ratio = [](const char* name, const Times& a, const Times& b) {
+        cout << left << setw(8) << "" << setw(8) << name
+             << right << setw(9) << setprecision(2) << a.insert / b.insert << "x"
+             << setw(9) << a.hit / b.hit << "x"
+             << setw(9) << a.miss / b.miss << "x\n";
+    };
+    cout << left << setw(16) << (to_string(Bytes) + "B values") << "\n";
+    row("AoS", aos);
+    row("SoA", soa);
+    row("SoASIMD", simd);
+    ratio("AoS/SoA", aos, soa);
+    ratio("SoA/SIMD", soa, simd);
+}
+
+int main() {
+    cout << "============================================================\n";
+    cout << "  ENTRY LAYOUT: AoS vs SoA vs SoASIMDKeys (ns/op, 85% load)\n";
+    cout << "============================================================\n\n";
+
+    const size_t n = 2000000;
+    mt19937_64 rng(42);
+    vector<uint64_t> keys(n);
+    for (auto& k : keys) k = rng();
+
+    vector<uint64_t> lookup_keys(keys.begin(), keys.begin() + n / 2);
+    shuffle(lookup_keys.begin(), lookup_keys.end(), rng);
+    vector<uint64_t> miss_keys(n / 2);
+    for (auto& k : miss_keys) k = rng();
+
+    cout << "Keys: " << n << "\n\n";
+    cout << left << setw(16) << ""
+         << right << setw(10) << "insert"
+         << setw(10) << "hit"
+         << setw(10) << "miss" << "\n";
+    cout << string(46, '-') << "\n";
+
+    compare<8>(keys, lookup_keys, miss_keys);
+    compare<32>(keys, lookup_keys, miss_keys);
+    compare<128>(keys, lookup_keys, miss_keys);
+
+    return 0;
+}
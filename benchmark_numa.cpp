@@ -0,0 +1,117 @@
+/**
+ * NUMA PLACEMENT
+ * ==============
+ * Random lookups from one pinned thread per CPU into a table built on one
+ * thread (all pages on its node), an interleaved table (NumaAllocator) and
+ * one replica per node (NumaReplicatedGroupedSIMD). On a single-node
+ * machine all three should match. Linux only (thread pinning).
+ */
+
+#include "numa_grouped_simd.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+using namespace std;
+using namespace std::chrono;
+
+// Million lookups per second over all CPUs, each thread pinned to one CPU
+template <typename FindFn>
+double run_pinned(FindFn&& find, const vector<uint64_t>& keys, size_t lookups_per_thread) {
+    size_t cpus = thread::hardware_concurrency();
+    vector<thread> workers;
+    auto start = high_resolution_clock::now();
+
+    for (size_t cpu = 0; cpu < cpus; ++cpu) {
+        workers.emplace_back([&, cpu]() {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+
+            mt19937_64 rng(3000 + cpu);
+            uint64_t sink = 0;
+            for (size_t i = 0; i < lookups_per_thread; ++i) {
+                const uint64_t* v = find(keys[rng() % keys.size()]);
+                if (v) sink += *v;
+            }
+            volatile uint64_t keep = sink;
+            (void)keep;
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    double secs = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+    return lookups_per_thread * cpus / secs / 1e6;
+}
+
+// Share of sampled entries on each node, e.g. "0:100%" or "0:50% 1:50%"
+template <typename Table>
+string placement(const Table& table, const vector<uint64_t>& keys) {
+    const auto& nodes = grouped_simd_detail::NumaTopology::instance().nodes;
+    vector<size_t> count(nodes.back() + 1, 0);
+    size_t samples = 1000;
+    for (size_t i = 0; i < samples; ++i) {
+        int node = grouped_simd_detail::numa_node_of(table.find(keys[i * (keys.size() / samples)]));
+        if (node >= 0 && node < static_cast<int>(count.size())) ++count[node];
+    }
+    string out;
+    for (int node : nodes) out += to_string(node) + ":" + to_string(count[node] * 100 / samples) + "% ";
+    return out;
+}
+
+int main() {
+    cout << "============================================================\n";
+    cout << "  NUMA PLACEMENT: first touch vs interleaved vs replicated\n";
+    cout << "============================================================\n\n";
+
+    const size_t n = 20000000;
+    const size_t lookups_per_thread = 2000000;
+    const auto& topology = grouped_simd_detail::NumaTopology::instance();
+    cout << "NUMA nodes: " << topology.nodes.size() << ", CPUs: " << thread::hardware_concurrency()
+         << ", keys: " << n << "\n\n";
+
+    mt19937_64 rng(42);
+    vector<uint64_t> keys(n), values(n);
+    for (size_t i = 0; i < n; ++i) { keys[i] = rng(); values[i] = i; }
+
+    cout << left << setw(14) << "Placement"
+         << right << setw(12) << "Mlookups/s"
+         << "   Entries per node\n";
+    cout << string(60, '-') << "\n";
+
+    double first_touch;
+    {
+        auto table = GroupedSIMDElastic<uint64_t, uint64_t>::build(keys.data(), values.data(), n, 1, 0.15);
+        first_touch = run_pinned([&](uint64_t k) { return table.find(k); }, keys, lookups_per_thread);
+        cout << left << setw(14) << "First touch"
+             << right << setw(12) << fixed << setprecision(1) << first_touch
+             << "   " << placement(table, keys) << "\n";
+    }
+    {
+        using Table = GroupedSIMDElastic<uint64_t, uint64_t, hash<uint64_t>, equal_to<uint64_t>,
+                                         NumaAllocator<uint8_t>>;
+        auto table = Table::build(keys.data(), values.data(), n, 1, 0.15);
+        double mops = run_pinned([&](uint64_t k) { return table.find(k); }, keys, lookups_per_thread);
+        cout << left << setw(14) << "Interleaved"
+             << right << setw(12) << mops
+             << "   " << placement(table, keys) << "\n";
+    }
+    {
+        NumaReplicatedGroupedSIMD<uint64_t, uint64_t> replicated(keys.data(), values.data(), n, 0, 0.15);
+        double mops = run_pinned([&](uint64_t k) { return replicated.find(k); }, keys, lookups_per_thread);
+        cout << left << setw(14) << "Replicated"
+             << right << setw(12) << mops
+             << "   " << replicated.replicas() << " copies, "
+             << setprecision(2) << mops / first_touch << "x first touch\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,262 @@
+/**
+ * Bucketed Grouped SIMD Hash Table
+ * ================================
+ *
+ * Cache-line blocks for small keys and values: each 64 or 128-byte block
+ * holds 16 control bytes followed by its entries, so the control bytes and
+ * the keys they describe share the block (F14-style). GroupedSIMDElastic
+ * keeps them in separate arrays, often on different pages:
+ *
+ * - A miss reads one block; a hit reads one block and nothing else. A
+ *   128-byte block is two adjacent lines, fetched in parallel (its second
+ *   line is prefetched with the first)
+ * - Half the pages per lookup, so half the TLB pressure at 100M entries
+ *
+ * Block layout: control bytes 0..SLOTS-1 tag the entries (EMPTY = 0x00,
+ * occupied = 0x80 | 7 hash bits, as in GroupedSIMDElastic), byte 14 counts
+ * keys whose probe passed this block full (saturating at 255). One SSE2
+ * compare scans a block. Blocks are probed triangularly
+ * (home + j(j+1)/2) over a power-of-two block count, which visits every
+ * block. A lookup ends at the first block with a zero counter, so erase
+ * just empties the slot and decrements counters: no tombstones.
+ *
+ * Meant for small entries (key + value <= 16 bytes, e.g. uint32/uint64 keys
+ * with a scalar or index value). Larger entries leave too few slots per
+ * block; use GroupedSIMDElastic with EntryLayout::SoA instead. Growth
+ * rehashes everything at once.
+ */
+
+#pragma once
+
+#include "grouped_simd_elastic.hpp"
+
+#if !GROUPED_SIMD_X86
+    #error "bucketed_grouped_simd.hpp needs x86: its control bytes are scanned with SSE2"
+#endif
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Allocator = std::allocator<uint8_t>>
+class BucketedGroupedSIMD {
+public:
+    struct Entry {
+        K key;
+        V value;
+    };
+
+    static_assert(sizeof(Entry) <= 16, "BucketedGroupedSIMD is for entries of at most 16 bytes");
+
+    // 64-byte blocks when that still fits 6+ entries, else 128 (7-14 entries)
+    static constexpr size_t BLOCK_BYTES = sizeof(Entry) <= 8 ? 64 : 128;
+    static constexpr size_t CONTROL_BYTES = 16;
+    static constexpr size_t SLOTS = std::min<size_t>(14, (BLOCK_BYTES - CONTROL_BYTES) / sizeof(Entry));
+
+private:
+    using SSE2Group = grouped_simd_detail::SSE2Group;
+
+    struct alignas(BLOCK_BYTES) Block {
+        uint8_t control[CONTROL_BYTES] = {};
+        Entry entries[SLOTS] = {};
+    };
+
+    static_assert(sizeof(Block) == BLOCK_BYTES, "Block must fill exactly its lines");
+
+    using BlockAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block>;
+
+    static constexpr uint8_t EMPTY = 0x00;
+    static constexpr size_t OVERFLOW_BYTE = 14;
+    static constexpr uint8_t OVERFLOW_SATURATED = 0xFF;
+    static constexpr uint32_t SLOT_MASK = (1u << SLOTS) - 1;  // Control bytes that tag entries
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    std::vector<Block, BlockAllocator> blocks_;
+    size_t block_mask_ = 0;  // Block count - 1
+    size_t size_ = 0;
+    size_t max_size_ = 0;    // Entries allowed before growing
+    double delta_;
+    uint64_t salt_;
+    Hash hasher_;
+    KeyEqual key_equal_;
+
+    uint64_t hash_with_salt(const K& key) const {
+        return grouped_simd_detail::hash_with_salt(hasher_, key, salt_);
+    }
+
+    // Block j of h's probe sequence follows block j - 1 after j more steps
+    size_t next_block(size_t b, size_t j) const {
+        return (b + j) & block_mask_;
+    }
+
+    const Block& home_block(uint64_t h) const {
+        const Block& block = blocks_[h & block_mask_];
+        if constexpr (BLOCK_BYTES > 64) {
+            // The entries past the first few are on the second line
+            grouped_simd_detail::prefetch(reinterpret_cast<const char*>(&block) + 64);
+        }
+        return block;
+    }
+
+    // Block and slot of key as (block << 4) | slot, or NOT_FOUND; probe
+    // length in j
+    size_t find_slot(const K& key, uint64_t h, size_t& j) const {
+        using grouped_simd_detail::lowest_bit;
+        uint8_t tag = grouped_simd_detail::make_metadata(h);
+        size_t b = h & block_mask_;
+        const Block* block = &home_block(h);
+
+        for (j = 0; j <= block_mask_; ++j) {
+            SSE2Group group(block->control);
+            uint32_t match = group.match(tag) & SLOT_MASK;
+            while (match != 0) {
+                size_t slot = lowest_bit(match);
+                if (key_equal_(block->entries[slot].key, key)) return (b << 4) | slot;
+                match &= match - 1;
+            }
+            if (block->control[OVERFLOW_BYTE] == 0) return NOT_FOUND;
+
+            b = next_block(b, j + 1);
+            block = &blocks_[b];
+        }
+        return NOT_FOUND;
+    }
+
+    // Free slot for a key known to be absent: first EMPTY slot in probe
+    // order. Counts the key in the overflow counter of every full block it
+    // passes.
+    Entry& place(uint64_t h) {
+        using grouped_simd_detail::lowest_bit;
+        size_t b = h & block_mask_;
+
+        for (size_t j = 0;; ++j) {
+            Block& block = blocks_[b];
+            uint32_t free_mask = SSE2Group(block.control).match_free() & SLOT_MASK;
+            if (free_mask != 0) {
+                size_t slot = lowest_bit(free_mask);
+                block.control[slot] = grouped_simd_detail::make_metadata(h);
+                return block.entries[slot];
+            }
+            if (block.control[OVERFLOW_BYTE] != OVERFLOW_SATURATED) ++block.control[OVERFLOW_BYTE];
+            b = next_block(b, j + 1);
+        }
+    }
+
+    void set_capacity(size_t blocks) {
+        blocks_.assign(blocks, Block{});
+        block_mask_ = blocks - 1;
+        max_size_ = static_cast<size_t>(blocks * SLOTS * (1.0 - delta_));
+    }
+
+    // Smallest power-of-two block count holding n entries within the load limit
+    size_t blocks_for(size_t n) const {
+        size_t blocks = 1;
+        while (static_cast<size_t>(blocks * SLOTS * (1.0 - delta_)) < n) blocks <<= 1;
+        return blocks;
+    }
+
+    void rehash(size_t blocks) {
+        std::vector<Block, BlockAllocator> old(blocks_.get_allocator());
+        old.swap(blocks_);
+        set_capacity(blocks);
+
+        for (Block& block : old) {
+            uint32_t used = ~static_cast<uint32_t>(SSE2Group(block.control).match_free()) & SLOT_MASK;
+            while (used != 0) {
+                size_t slot = grouped_simd_detail::lowest_bit(used);
+                Entry& e = block.entries[slot];
+                place(hash_with_salt(e.key)) = std::move(e);
+                used &= used - 1;
+            }
+        }
+    }
+
+    template <typename KeyArg, typename... Args>
+    std::pair<V*, bool> try_emplace_impl(KeyArg&& key, Args&&... args) {
+        uint64_t h = hash_with_salt(key);
+        size_t j;
+        size_t found = find_slot(key, h, j);
+        if (found != NOT_FOUND) return {&blocks_[found >> 4].entries[found & 15].value, false};
+
+        if (size_ >= max_size_) rehash((block_mask_ + 1) * 2);
+
+        Entry& e = place(h);
+        e.key = K(std::forward<KeyArg>(key));
+        e.value = V(std::forward<Args>(args)...);
+        ++size_;
+        return {&e.value, true};
+    }
+
+public:
+    // capacity is in entries, rounded up to a power-of-two number of blocks;
+    // delta is 1 - max load factor, as in GroupedSIMDElastic
+    explicit BucketedGroupedSIMD(size_t capacity, double delta = 0.1, const Allocator& alloc = Allocator())
+        : blocks_(BlockAllocator(alloc)), delta_(delta)
+    {
+        if (delta <= 0 || delta >= 1) throw std::invalid_argument("Delta must be in (0,1)");
+        set_capacity(blocks_for(capacity > 0 ? capacity : 1));
+
+        std::random_device rd;
+        salt_ = rd();
+    }
+
+    // Insert or update; true if key was new
+    bool insert(const K& key, const V& value) {
+        auto r = try_emplace_impl(key, value);
+        if (!r.second) *r.first = value;
+        return r.second;
+    }
+
+    // Insert V(args...) if key is absent; {value, inserted}
+    template <typename... Args>
+    std::pair<V*, bool> try_emplace(const K& key, Args&&... args) {
+        return try_emplace_impl(key, std::forward<Args>(args)...);
+    }
+
+    V* find(const K& key) {
+        return const_cast<V*>(static_cast<const BucketedGroupedSIMD*>(this)->find(key));
+    }
+
+    const V* find(const K& key) const {
+        size_t j;
+        size_t found = find_slot(key, hash_with_salt(key), j);
+        return found == NOT_FOUND ? nullptr : &blocks_[found >> 4].entries[found & 15].value;
+    }
+
+    bool contains(const K& key) const {
+        return find(key) != nullptr;
+    }
+
+    // Empty the slot and take the key out of the counters it added to
+    bool erase(const K& key) {
+        uint64_t h = hash_with_salt(key);
+        size_t j;
+        size_t found = find_slot(key, h, j);
+        if (found == NOT_FOUND) return false;
+
+        Block& block = blocks_[found >> 4];
+        block.control[found & 15] = EMPTY;
+        block.entries[found & 15] = Entry{};
+        --size_;
+
+        size_t b = h & block_mask_;
+        for (size_t step = 0; step < j; ++step) {
+            uint8_t& overflow = blocks_[b].control[OVERFLOW_BYTE];
+            if (overflow != OVERFLOW_SATURATED) --overflow;
+            b = next_block(b, step + 1);
+        }
+        return true;
+    }
+
+    V& operator[](const K& key) {
+        return *try_emplace(key).first;
+    }
+
+    // Grow now so that n entries fit without further rehashing
+    void reserve(size_t n) {
+        size_t blocks = blocks_for(n);
+        if (blocks > block_mask_ + 1) rehash(blocks);
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return (block_mask_ + 1) * SLOTS; }
+    double load_factor() const { return static_cast<double>(size_) / capacity(); }
+    size_t block_count() const { return block_mask_ + 1; }
+};
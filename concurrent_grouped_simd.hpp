@@ -0,0 +1,751 @@
+/**
+ * Concurrent Grouped SIMD Hash Table
+ * ==================================
+ *
+ * Lock-free multi-writer inserts: a writer claims a slot with one
+ * compare-exchange on its metadata byte.
+ *
+ * Slot states:
+ * - EMPTY (0x00): free
+ * - BUSY (0x02): claimed, entry being written; not EMPTY, never matches a
+ *   fragment (no occupied bit)
+ * - MOVED (0x03): was EMPTY, frozen by a resize; ends a probe like EMPTY but
+ *   can no longer be claimed
+ * - 0x80 | fragment: published, entry is immutable from now on
+ *
+ * Insert walks the usual grouped probe sequence:
+ * 1. SIMD-scan the group. BUSY slots may be our key in flight: wait for them
+ *    to publish, then rescan.
+ * 2. Confirm fragment matches (acquire load of the byte, then key compare).
+ *    A hit means the key is already present.
+ * 3. If the group has an EMPTY slot, CAS the first one EMPTY -> BUSY, write
+ *    the entry, then publish the fragment with a release store. A failed CAS
+ *    rescans the group.
+ *
+ * Two writers of the same key see the same sequence and both go for its
+ * first EMPTY slot (slots never become EMPTY again), so exactly one wins and
+ * the other finds it on the rescan. Writers hold BUSY only while copying the
+ * entry in, and never wait while holding it.
+ *
+ * Readers take no locks and write nothing shared: the group scan is a plain
+ * SIMD load racing with the byte stores (each byte is read whole on x86) or,
+ * with SWAR, relaxed atomic word loads, and every candidate is confirmed with
+ * an acquire load before its key is read.
+ *
+ * Resize: the slot arrays live in a Table reached through an atomic pointer.
+ * The insert that crosses the load limit hangs a table of twice the capacity
+ * off the current one (Table::next). From then on every insert helps migrate
+ * before doing its own work: threads claim chunks of old slots, freeze the
+ * EMPTY ones to MOVED and copy the published ones into the new table. The
+ * thread that finishes the last chunk swings the current pointer. Readers
+ * never wait: old entries stay readable where they are, and a miss in a
+ * table being migrated is retried in its successor.
+ *
+ * Old tables are freed by epoch-based reclamation. Every operation announces
+ * the global epoch it started in; a retired table is freed once no thread is
+ * still inside an epoch older than the one it was retired in. On Linux the
+ * announcement costs readers only a compiler barrier: the reclaimer issues
+ * membarrier() to fence every running thread instead.
+ */
+
+#pragma once
+
+#include "grouped_simd_elastic.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace grouped_simd_detail {
+
+// Single-byte atomics on plain metadata storage (the SIMD scan needs the
+// bytes contiguous, which std::atomic<uint8_t> does not promise)
+inline uint8_t load_acquire(const uint8_t* p) {
+    #ifdef _MSC_VER
+        uint8_t v = *static_cast<const volatile uint8_t*>(p);  // x86: loads are acquire
+        _ReadWriteBarrier();
+        return v;
+    #else
+        return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+    #endif
+}
+
+inline void store_release(uint8_t* p, uint8_t v) {
+    #ifdef _MSC_VER
+        _ReadWriteBarrier();
+        *static_cast<volatile uint8_t*>(p) = v;  // x86: stores are release
+    #else
+        __atomic_store_n(p, v, __ATOMIC_RELEASE);
+    #endif
+}
+
+inline bool compare_exchange(uint8_t* p, uint8_t expected, uint8_t desired) {
+    #ifdef _MSC_VER
+        return static_cast<uint8_t>(_InterlockedCompareExchange8(
+            reinterpret_cast<volatile char*>(p), static_cast<char>(desired),
+            static_cast<char>(expected))) == expected;
+    #else
+        return __atomic_compare_exchange_n(p, &expected, desired, false,
+                                           __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    #endif
+}
+
+// SWAR group over metadata that other threads store to. The scan reads the
+// one or two aligned words under its eight bytes with relaxed atomic loads:
+// a plain load racing with the byte stores is only benign on x86, and off x86
+// SWAR is the only backend. Metadata is in whole 64-byte lines, so both
+// words are inside it.
+struct AtomicSWARGroup : SWARGroup {
+    struct Bytes {
+        uint8_t b[8];
+    };
+
+    static uint64_t load_word(const uint64_t* p) {
+        #ifdef _MSC_VER
+            return *static_cast<const volatile uint64_t*>(p);
+        #else
+            return __atomic_load_n(p, __ATOMIC_RELAXED);
+        #endif
+    }
+
+    static Bytes load(const uint8_t* p) {
+        uintptr_t addr = reinterpret_cast<uintptr_t>(p);
+        const uint64_t* word = reinterpret_cast<const uint64_t*>(addr & ~static_cast<uintptr_t>(7));
+        size_t offset = addr & 7;
+
+        // Both words in memory order, so byte i of p is byte offset + i
+        Bytes words[2];
+        uint64_t first = load_word(word);
+        std::memcpy(words[0].b, &first, 8);
+        if (offset != 0) {
+            uint64_t second = load_word(word + 1);
+            std::memcpy(words[1].b, &second, 8);
+        }
+        Bytes out;
+        std::memcpy(out.b, words[0].b + offset, 8 - offset);
+        std::memcpy(out.b + 8 - offset, words[1].b, offset);
+        return out;
+    }
+
+    explicit AtomicSWARGroup(const uint8_t* p) : SWARGroup(load(p).b) {}
+};
+
+inline void cpu_relax() {
+    #if GROUPED_SIMD_X86
+        _mm_pause();
+    #elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+        __asm__ volatile("yield");
+    #endif
+}
+
+// One per thread, on its own cache line; reused after the thread exits
+struct alignas(64) EpochRecord {
+    std::atomic<uint64_t> epoch{0};  // 0 = not inside an operation
+    std::atomic<bool> in_use{true};
+    EpochRecord* next = nullptr;
+};
+
+// Process-wide epoch clock and registry of per-thread records. Records are
+// never freed, so a scan of the list needs no protection itself.
+class EpochDomain {
+    std::atomic<uint64_t> epoch_{1};
+    std::atomic<EpochRecord*> records_{nullptr};
+    bool asymmetric_;  // membarrier() registered: readers skip the full fence
+
+    EpochDomain() {
+        #ifdef __linux__
+            asymmetric_ = syscall(__NR_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+        #else
+            asymmetric_ = false;
+        #endif
+    }
+
+    EpochRecord* acquire_record() {
+        for (EpochRecord* r = records_.load(std::memory_order_acquire); r; r = r->next) {
+            bool expected = false;
+            if (!r->in_use.load(std::memory_order_relaxed) &&
+                r->in_use.compare_exchange_strong(expected, true)) {
+                return r;
+            }
+        }
+        EpochRecord* r = new EpochRecord;
+        r->next = records_.load(std::memory_order_relaxed);
+        while (!records_.compare_exchange_weak(r->next, r, std::memory_order_release,
+                                               std::memory_order_relaxed)) {}
+        return r;
+    }
+
+    static EpochRecord& register_thread(EpochRecord*& cached) {
+        struct Owner {
+            EpochRecord* record;
+            ~Owner() { record->in_use.store(false, std::memory_order_release); }
+        };
+        thread_local Owner owner{instance().acquire_record()};
+        cached = owner.record;
+        return *cached;
+    }
+
+public:
+    static EpochDomain& instance() {
+        static EpochDomain* domain = new EpochDomain;  // Outlives thread_local records
+        return *domain;
+    }
+
+    // Constant-initialized, so the fast path has no thread_local init guard
+    static EpochRecord& local() {
+        thread_local EpochRecord* cached = nullptr;
+        return cached ? *cached : register_thread(cached);
+    }
+
+    // Enter epoch: the announcement must be visible before the caller loads
+    // any table pointer
+    void enter(EpochRecord& r) {
+        uint64_t e = epoch_.load(std::memory_order_acquire);
+        if (asymmetric_) {
+            r.epoch.store(e, std::memory_order_relaxed);
+            std::atomic_signal_fence(std::memory_order_seq_cst);  // Paired with membarrier()
+        } else {
+            r.epoch.exchange(e, std::memory_order_seq_cst);
+        }
+    }
+
+    // Start a new epoch; returns it
+    uint64_t advance() {
+        return epoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+    }
+
+    // Oldest epoch any thread is still inside, or UINT64_MAX
+    uint64_t oldest_active() {
+        #ifdef __linux__
+            if (asymmetric_) syscall(__NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+        #endif
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint64_t oldest = UINT64_MAX;
+        for (EpochRecord* r = records_.load(std::memory_order_acquire); r; r = r->next) {
+            uint64_t e = r->epoch.load(std::memory_order_seq_cst);
+            if (e != 0 && e < oldest) oldest = e;
+        }
+        return oldest;
+    }
+};
+
+// Marks the calling thread as inside an operation for its scope. Nested
+// guards are no-ops.
+class EpochGuard {
+    EpochRecord& record_;
+    bool outer_;
+
+public:
+    EpochGuard()
+        : record_(EpochDomain::local()),
+          outer_(record_.epoch.load(std::memory_order_relaxed) == 0)
+    {
+        if (outer_) EpochDomain::instance().enter(record_);
+    }
+
+    ~EpochGuard() {
+        if (outer_) record_.epoch.store(0, std::memory_order_release);
+    }
+
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+}  // namespace grouped_simd_detail
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class ConcurrentGroupedSIMD {
+public:
+    struct Entry {
+        K key;
+        V value;
+    };
+
+private:
+    using MetadataLine = grouped_simd_detail::MetadataLine;
+    using SSE2Group = grouped_simd_detail::SSE2Group;
+    using AVX2Group = grouped_simd_detail::AVX2Group;
+    using AVX512Group = grouped_simd_detail::AVX512Group;
+    using SWARGroup = grouped_simd_detail::AtomicSWARGroup;
+    using EpochDomain = grouped_simd_detail::EpochDomain;
+    using EpochGuard = grouped_simd_detail::EpochGuard;
+
+    static constexpr double C = 4.0;
+    static constexpr size_t MAX_GROUP_SIZE = 64;
+    static constexpr size_t MIRROR_SIZE = MAX_GROUP_SIZE - 1;
+    static constexpr size_t MIGRATE_CHUNK = 4096;  // Old slots per migration work unit
+    static constexpr uint8_t EMPTY = 0x00;
+    static constexpr uint8_t BUSY = 0x02;   // Claimed by a writer, not yet published
+    static constexpr uint8_t MOVED = 0x03;  // Frozen EMPTY slot of a table being migrated
+
+    struct Table {
+        // Metadata as in GroupedSIMDElastic, mirrored tail included
+        std::vector<MetadataLine> lines;
+        std::vector<Entry> entries;
+        size_t capacity;
+        size_t mask;  // capacity - 1 in power-of-two mode, else 0
+        size_t max_inserts;
+        size_t total_groups;
+        std::atomic<size_t> max_group_used{0};
+        std::atomic<Table*> next{nullptr};  // Successor, set once when a resize starts
+
+        // Migration progress, away from the fields readers touch
+        alignas(64) std::atomic<size_t> migrate_cursor{0};  // Next chunk to claim
+        std::atomic<size_t> chunks_done{0};
+        std::atomic<bool> migration_failed{false};  // An entry did not fit in next
+
+        Table(size_t capacity_, bool power_of_two, double delta, size_t group_size)
+            : lines((capacity_ + MIRROR_SIZE + sizeof(MetadataLine) - 1) / sizeof(MetadataLine)),
+              entries(capacity_),
+              capacity(capacity_),
+              mask(power_of_two ? capacity_ - 1 : 0),
+              max_inserts(capacity_ - static_cast<size_t>(delta * capacity_))
+        {
+            size_t recommended = static_cast<size_t>(C * std::log2(1.0 / delta) * 4) + 8;
+            size_t max_possible = (capacity_ + group_size - 1) / group_size;
+            total_groups = recommended < max_possible ? recommended : max_possible;
+        }
+
+        uint8_t* metadata() { return lines.front().bytes; }
+        const uint8_t* metadata() const { return lines.front().bytes; }
+        size_t chunk_count() const { return (capacity + MIGRATE_CHUNK - 1) / MIGRATE_CHUNK; }
+    };
+
+    enum class InsertResult { Inserted, Present, Retry };
+
+    std::atomic<Table*> current_;
+    std::atomic<size_t> size_{0};
+    double delta_;
+    bool power_of_two_;
+    uint64_t salt_;
+    Hash hasher_;
+    KeyEqual key_equal_;
+    GroupBackend backend_;
+    size_t group_size_;
+
+    // Tables that have been fully migrated, with the epoch they were retired in
+    std::mutex retire_lock_;
+    std::vector<std::pair<Table*, uint64_t>> retired_;
+    std::atomic<size_t> retired_count_{0};
+
+    template <typename Q>
+    uint64_t hash_with_salt(const Q& key) const {
+        return grouped_simd_detail::hash_with_salt(hasher_, key, salt_);
+    }
+
+    template <typename Group>
+    static size_t group_base(const Table& t, uint64_t h, size_t group_idx) {
+        return grouped_simd_detail::group_base<Group>(h, group_idx, t.capacity, t.mask);
+    }
+
+    static size_t slot_in_group(const Table& t, size_t base, size_t offset) {
+        size_t idx = base + offset;
+        return (idx >= t.capacity) ? idx - t.capacity : idx;
+    }
+
+    // Mirror first, primary (release) last: once a reader acquires the new
+    // primary byte, the mirror is current too
+    static void publish(Table& t, size_t idx, uint8_t m) {
+        if (idx < MIRROR_SIZE) grouped_simd_detail::store_release(t.metadata() + t.capacity + idx, m);
+        grouped_simd_detail::store_release(t.metadata() + idx, m);
+    }
+
+    static void note_group_used(Table& t, size_t g) {
+        size_t seen = t.max_group_used.load(std::memory_order_relaxed);
+        while (g > seen && !t.max_group_used.compare_exchange_weak(seen, g, std::memory_order_release)) {}
+    }
+
+    template <typename Group>
+    const Entry* find_impl(const Table& t, const K& key, uint64_t h) const {
+        using grouped_simd_detail::lowest_bit;
+        using grouped_simd_detail::load_acquire;
+        uint8_t meta = grouped_simd_detail::make_metadata(h);
+        size_t groups_to_check = t.max_group_used.load(std::memory_order_acquire) + 1;
+
+        for (size_t g = 0; g < groups_to_check; ++g) {
+            size_t base = group_base<Group>(t, h, g);
+            Group group(t.metadata() + base);
+
+            auto match_mask = group.match(meta);
+            while (match_mask != 0) {
+                size_t idx = slot_in_group(t, base, lowest_bit(match_mask));
+                if (load_acquire(t.metadata() + idx) == meta && key_equal_(t.entries[idx].key, key)) {
+                    return &t.entries[idx];
+                }
+                match_mask &= (match_mask - 1);
+            }
+
+            // A BUSY slot is an insert not yet published: not visible yet
+            if ((group.match(EMPTY) | group.match(MOVED)) != 0) return nullptr;
+        }
+
+        return nullptr;
+    }
+
+    template <typename Group>
+    InsertResult insert_impl(Table& t, const K& key, const V& value, uint64_t h) {
+        using grouped_simd_detail::lowest_bit;
+        using grouped_simd_detail::load_acquire;
+        uint8_t meta = grouped_simd_detail::make_metadata(h);
+
+        for (size_t g = 0; g < t.total_groups; ++g) {
+            size_t base = group_base<Group>(t, h, g);
+
+            for (;;) {
+                Group group(t.metadata() + base);
+
+                // Wait out claims in flight: any of them may be this key
+                auto busy_mask = group.match(BUSY);
+                if (busy_mask != 0) {
+                    size_t idx = slot_in_group(t, base, lowest_bit(busy_mask));
+                    while (load_acquire(t.metadata() + idx) == BUSY) grouped_simd_detail::cpu_relax();
+                    continue;
+                }
+
+                auto match_mask = group.match(meta);
+                while (match_mask != 0) {
+                    size_t idx = slot_in_group(t, base, lowest_bit(match_mask));
+                    if (load_acquire(t.metadata() + idx) == meta && key_equal_(t.entries[idx].key, key)) {
+                        return InsertResult::Present;
+                    }
+                    match_mask &= (match_mask - 1);
+                }
+
+                // A resize froze this group: the key belongs in the successor
+                if (group.match(MOVED) != 0) return InsertResult::Retry;
+
+                auto empty_mask = group.match(EMPTY);
+                if (empty_mask == 0) break;  // Full group: key is further along
+
+                // Reserve room before claiming: a claimed slot never goes back
+                // to EMPTY
+                if (size_.fetch_add(1, std::memory_order_relaxed) >= t.max_inserts) {
+                    size_.fetch_sub(1, std::memory_order_relaxed);
+                    start_resize(t);
+                    return InsertResult::Retry;
+                }
+
+                size_t idx = slot_in_group(t, base, lowest_bit(empty_mask));
+                if (!grouped_simd_detail::compare_exchange(t.metadata() + idx, EMPTY, BUSY)) {
+                    size_.fetch_sub(1, std::memory_order_relaxed);
+                    continue;  // Lost the slot: rescan, it may now hold key
+                }
+                if (idx < MIRROR_SIZE) grouped_simd_detail::store_release(t.metadata() + t.capacity + idx, BUSY);
+
+                t.entries[idx].key = key;
+                t.entries[idx].value = value;
+                note_group_used(t, g);
+                publish(t, idx, meta);
+                return InsertResult::Inserted;
+            }
+        }
+
+        start_resize(t);  // Probe sequence exhausted
+        return InsertResult::Retry;
+    }
+
+    // Copy one entry into a table under migration. Keys are unique and only
+    // migrating threads write to it, so no presence check is needed. False
+    // if h's whole probe sequence is full.
+    template <typename Group>
+    bool place(Table& t, const Entry& e, uint64_t h) {
+        using grouped_simd_detail::lowest_bit;
+        for (size_t g = 0; g < t.total_groups; ++g) {
+            size_t base = group_base<Group>(t, h, g);
+            for (;;) {
+                auto empty_mask = Group(t.metadata() + base).match(EMPTY);
+                if (empty_mask == 0) break;
+
+                size_t idx = slot_in_group(t, base, lowest_bit(empty_mask));
+                if (!grouped_simd_detail::compare_exchange(t.metadata() + idx, EMPTY, BUSY)) continue;
+                if (idx < MIRROR_SIZE) grouped_simd_detail::store_release(t.metadata() + t.capacity + idx, BUSY);
+
+                t.entries[idx] = e;
+                note_group_used(t, g);
+                publish(t, idx, grouped_simd_detail::make_metadata(h));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Freeze or copy every slot of one chunk of from. False, with the chunk
+    // left unfinished, if an entry did not fit in to.
+    template <typename Group>
+    bool migrate_chunk_impl(Table& from, Table& to, size_t chunk) {
+        using grouped_simd_detail::load_acquire;
+        size_t begin = chunk * MIGRATE_CHUNK;
+        size_t end = std::min(begin + MIGRATE_CHUNK, from.capacity);
+
+        for (size_t i = begin; i < end; ++i) {
+            uint8_t* m = from.metadata() + i;
+            for (;;) {
+                uint8_t b = load_acquire(m);
+                if (b == EMPTY) {
+                    if (!grouped_simd_detail::compare_exchange(m, EMPTY, MOVED)) continue;
+                    if (i < MIRROR_SIZE) grouped_simd_detail::store_release(from.metadata() + from.capacity + i, MOVED);
+                    break;
+                }
+                if (b == BUSY) {
+                    grouped_simd_detail::cpu_relax();
+                    continue;
+                }
+                // Published: immutable, and stays readable here until reclaimed
+                if (!place<Group>(to, from.entries[i], hash_with_salt(from.entries[i].key))) return false;
+                break;
+            }
+        }
+        return true;
+    }
+
+    GROUPED_SIMD_TARGET_FLATTEN("avx2")
+    const Entry* find_avx2(const Table& t, const K& key, uint64_t h) const {
+        return find_impl<AVX2Group>(t, key, h);
+    }
+
+    GROUPED_SIMD_TARGET_FLATTEN("avx2")
+    InsertResult insert_avx2(Table& t, const K& key, const V& value, uint64_t h) {
+        return insert_impl<AVX2Group>(t, key, value, h);
+    }
+
+    GROUPED_SIMD_TARGET_FLATTEN("avx2")
+    bool migrate_chunk_avx2(Table& from, Table& to, size_t chunk) {
+        return migrate_chunk_impl<AVX2Group>(from, to, chunk);
+    }
+
+    GROUPED_SIMD_TARGET_FLATTEN("avx512f,avx512bw")
+    const Entry* find_avx512(const Table& t, const K& key, uint64_t h) const {
+        return find_impl<AVX512Group>(t, key, h);
+    }
+
+    GROUPED_SIMD_TARGET_FLATTEN("avx512f,avx512bw")
+    InsertResult insert_avx512(Table& t, const K& key, const V& value, uint64_t h) {
+        return insert_impl<AVX512Group>(t, key, value, h);
+    }
+
+    GROUPED_SIMD_TARGET_FLATTEN("avx512f,avx512bw")
+    bool migrate_chunk_avx512(Table& from, Table& to, size_t chunk) {
+        return migrate_chunk_impl<AVX512Group>(from, to, chunk);
+    }
+
+    const Entry* find_in(const Table& t, const K& key, uint64_t h) const {
+        switch (backend_) {
+        case GroupBackend::AVX512: return find_avx512(t, key, h);
+        case GroupBackend::AVX2: return find_avx2(t, key, h);
+        case GroupBackend::SWAR: return find_impl<SWARGroup>(t, key, h);
+        default: return find_impl<SSE2Group>(t, key, h);
+        }
+    }
+
+    // Hang a table of twice the capacity off t, unless another thread already
+    // has. Losers of the race free theirs.
+    void start_resize(Table& t) {
+        if (t.next.load(std::memory_order_acquire)) return;
+        Table* next = new Table(t.capacity * 2, power_of_two_, delta_, group_size_);
+        Table* expected = nullptr;
+        if (!t.next.compare_exchange_strong(expected, next, std::memory_order_acq_rel)) delete next;
+    }
+
+    // Migrate chunks of t until none are left unclaimed, then wait for the
+    // other helpers. Returns once t is no longer the current table.
+    //
+    // next has twice t's capacity and receives at most t's load limit, so it
+    // is at most half full: an entry fails to fit only if the hash sends more
+    // keys down one probe sequence than it has slots, and a larger successor
+    // would probe no more groups. The migration then fails instead of
+    // leaving its chunk unfinished, and every helper, now and later, throws
+    // std::length_error rather than waiting for a swing that never comes.
+    void help_migrate(Table& t) {
+        Table& next = *t.next.load(std::memory_order_acquire);
+        size_t chunks = t.chunk_count();
+
+        while (!t.migration_failed.load(std::memory_order_acquire)) {
+            size_t chunk = t.migrate_cursor.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunks) break;
+
+            bool migrated;
+            switch (backend_) {
+            case GroupBackend::AVX512: migrated = migrate_chunk_avx512(t, next, chunk); break;
+            case GroupBackend::AVX2: migrated = migrate_chunk_avx2(t, next, chunk); break;
+            case GroupBackend::SWAR: migrated = migrate_chunk_impl<SWARGroup>(t, next, chunk); break;
+            default: migrated = migrate_chunk_impl<SSE2Group>(t, next, chunk); break;
+            }
+
+            if (!migrated) {
+                // The chunk is never counted done, so current_ stays on t
+                t.migration_failed.store(true, std::memory_order_release);
+                break;
+            }
+
+            if (t.chunks_done.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks) {
+                current_.store(&next, std::memory_order_seq_cst);
+                retire(&t);
+                return;
+            }
+        }
+
+        while (current_.load(std::memory_order_acquire) == &t) {
+            if (t.migration_failed.load(std::memory_order_acquire)) {
+                throw std::length_error("ConcurrentGroupedSIMD: probe sequence exhausted during resize");
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    // Called after current_ has moved past t
+    void retire(Table* t) {
+        uint64_t epoch = EpochDomain::instance().advance();
+        std::lock_guard<std::mutex> guard(retire_lock_);
+        retired_.push_back({t, epoch});
+        retired_count_.store(retired_.size(), std::memory_order_relaxed);
+    }
+
+    // Free retired tables that no thread can still be reading. Must not be
+    // called inside an EpochGuard: our own epoch would hold them back.
+    void reclaim() {
+        std::unique_lock<std::mutex> guard(retire_lock_, std::try_to_lock);
+        if (!guard.owns_lock()) return;
+
+        uint64_t oldest = EpochDomain::instance().oldest_active();
+        auto kept = std::remove_if(retired_.begin(), retired_.end(), [&](const std::pair<Table*, uint64_t>& r) {
+            if (r.second > oldest) return false;
+            delete r.first;
+            return true;
+        });
+        retired_.erase(kept, retired_.end());
+        retired_count_.store(retired_.size(), std::memory_order_relaxed);
+    }
+
+public:
+    // Same parameters as GroupedSIMDElastic. capacity is the initial size:
+    // the table doubles whenever inserts pass the 1 - delta load limit.
+    explicit ConcurrentGroupedSIMD(size_t capacity, double delta = 0.1, bool power_of_two = false,
+                                   GroupBackend backend = GroupBackend::Auto)
+    {
+        if (capacity == 0) throw std::invalid_argument("Capacity must be positive");
+        if (delta <= 0 || delta >= 1) throw std::invalid_argument("Delta must be in (0,1)");
+
+        if (backend == GroupBackend::Auto) backend = grouped_simd_detail::best_backend();
+        if (!grouped_simd_detail::cpu_supports(backend)) {
+            throw std::invalid_argument("Group backend not supported by this CPU");
+        }
+        backend_ = backend;
+        group_size_ = backend == GroupBackend::AVX512 ? AVX512Group::WIDTH
+                    : backend == GroupBackend::AVX2 ? AVX2Group::WIDTH
+                    : backend == GroupBackend::SWAR ? SWARGroup::WIDTH
+                    : SSE2Group::WIDTH;
+
+        if (capacity < MAX_GROUP_SIZE) capacity = MAX_GROUP_SIZE;
+        if (power_of_two) {
+            size_t rounded = MAX_GROUP_SIZE;
+            while (rounded < capacity) rounded <<= 1;
+            capacity = rounded;
+        }
+
+        delta_ = delta;
+        power_of_two_ = power_of_two;
+        current_.store(new Table(capacity, power_of_two, delta, group_size_), std::memory_order_relaxed);
+
+        std::random_device rd;
+        salt_ = rd();
+    }
+
+    // No operation may be in flight
+    ~ConcurrentGroupedSIMD() {
+        Table* t = current_.load(std::memory_order_relaxed);
+        while (t) {
+            Table* next = t->next.load(std::memory_order_relaxed);
+            delete t;
+            t = next;
+        }
+        for (auto& r : retired_) delete r.first;
+    }
+
+    ConcurrentGroupedSIMD(const ConcurrentGroupedSIMD&) = delete;
+    ConcurrentGroupedSIMD& operator=(const ConcurrentGroupedSIMD&) = delete;
+
+    // Insert key if absent. Returns false if it was already present (the
+    // stored value is left as is). Safe to call from any number of threads.
+    // While a resize is running, inserts help migrate before they proceed.
+    // Throws std::length_error if a resize cannot place an entry (see
+    // help_migrate()); the table then stays readable but takes no inserts.
+    bool insert(const K& key, const V& value) {
+        uint64_t h = hash_with_salt(key);
+        InsertResult result;
+        {
+            EpochGuard guard;
+            for (;;) {
+                Table& t = *current_.load(std::memory_order_acquire);
+                if (t.next.load(std::memory_order_acquire)) {
+                    help_migrate(t);
+                    continue;
+                }
+
+                switch (backend_) {
+                case GroupBackend::AVX512: result = insert_avx512(t, key, value, h); break;
+                case GroupBackend::AVX2: result = insert_avx2(t, key, value, h); break;
+                case GroupBackend::SWAR: result = insert_impl<SWARGroup>(t, key, value, h); break;
+                default: result = insert_impl<SSE2Group>(t, key, value, h); break;
+                }
+                if (result != InsertResult::Retry) break;
+            }
+        }
+
+        if (retired_count_.load(std::memory_order_relaxed) != 0) reclaim();
+        return result == InsertResult::Inserted;
+    }
+
+    // Lock-free lookup, concurrent with inserts and resizes; copies the
+    // value into out. Keys whose insert has not published yet are not found.
+    bool find(const K& key, V& out) const {
+        uint64_t h = hash_with_salt(key);
+        EpochGuard guard;
+        // A miss in a table under migration may be a key inserted into its
+        // successor after the migration finished
+        for (const Table* t = current_.load(std::memory_order_acquire); t;
+             t = t->next.load(std::memory_order_acquire)) {
+            if (const Entry* e = find_in(*t, key, h)) {
+                out = e->value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool contains(const K& key) const {
+        uint64_t h = hash_with_salt(key);
+        EpochGuard guard;
+        for (const Table* t = current_.load(std::memory_order_acquire); t;
+             t = t->next.load(std::memory_order_acquire)) {
+            if (find_in(*t, key, h)) return true;
+        }
+        return false;
+    }
+
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+    size_t capacity() const {
+        EpochGuard guard;
+        return current_.load(std::memory_order_acquire)->capacity;
+    }
+
+    double load_factor() const {
+        EpochGuard guard;
+        return static_cast<double>(size()) / current_.load(std::memory_order_acquire)->capacity;
+    }
+
+    size_t max_group_used() const {
+        EpochGuard guard;
+        return current_.load(std::memory_order_acquire)->max_group_used.load(std::memory_order_relaxed);
+    }
+
+    GroupBackend backend() const { return backend_; }
+    size_t group_size() const { return group_size_; }
+};
@@ -0,0 +1,347 @@
+/**
+ * Direct-Key Grouped SIMD Hash Table
+ * ==================================
+ *
+ * uint32_t keys (dictionary-encoding IDs and the like) compared directly,
+ * with no metadata bytes: a 32-bit key is only four times the size of its
+ * metadata byte, so scanning the keys themselves costs little and drops the
+ * metadata array and its cache miss from every lookup.
+ *
+ * - Keys live in 64-byte lines of 16; a group is one line, scanned with four
+ *   SSE2, two AVX2 or one AVX-512 compare against the broadcast key
+ * - Two key values are reserved: empty_key (UINT32_MAX by default) marks a
+ *   free slot and empty_key - 1 a tombstone. They cannot be stored
+ * - A miss reads one key line per group probed and stops at the first group
+ *   with an empty slot; a hit reads its key line and the value
+ * - Groups are probed quadratically (home + j(j+1)/2) over a power-of-two
+ *   group count, which visits every group
+ *
+ * Values sit in a separate array, slot for slot. Growth rehashes everything
+ * at once, dropping tombstones.
+ */
+
+#pragma once
+
+#include "grouped_simd_elastic.hpp"
+
+#if !GROUPED_SIMD_X86
+    #error "direct_key_grouped_simd.hpp needs x86: its key lines are scanned with SSE2/AVX2/AVX-512"
+#endif
+
+namespace grouped_simd_detail {
+
+// Direct-key kernels load one line of 16 uint32 keys and answer match(key)
+// with one bit per slot holding exactly key
+struct SSE2KeyGroup {
+    __m128i keys[4];
+
+    explicit SSE2KeyGroup(const uint32_t* p) {
+        for (int i = 0; i < 4; ++i) keys[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(p) + i);
+    }
+
+    uint32_t match(uint32_t key) const {
+        __m128i target = _mm_set1_epi32(static_cast<int>(key));
+        // Narrow the four 32-bit compare results to 16 bytes, one per slot
+        __m128i lo = _mm_packs_epi32(_mm_cmpeq_epi32(keys[0], target), _mm_cmpeq_epi32(keys[1], target));
+        __m128i hi = _mm_packs_epi32(_mm_cmpeq_epi32(keys[2], target), _mm_cmpeq_epi32(keys[3], target));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(lo, hi)));
+    }
+};
+
+struct AVX2KeyGroup {
+    __m256i keys[2];
+
+    GROUPED_SIMD_TARGET("avx2")
+    explicit AVX2KeyGroup(const uint32_t* p) {
+        keys[0] = _mm256_load_si256(reinterpret_cast<const __m256i*>(p));
+        keys[1] = _mm256_load_si256(reinterpret_cast<const __m256i*>(p) + 1);
+    }
+
+    GROUPED_SIMD_TARGET("avx2")
+    uint32_t match(uint32_t key) const {
+        __m256i target = _mm256_set1_epi32(static_cast<int>(key));
+        uint32_t lo = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(keys[0], target)));
+        uint32_t hi = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(keys[1], target)));
+        return lo | (hi << 8);
+    }
+};
+
+struct AVX512KeyGroup {
+    __m512i keys;
+
+    GROUPED_SIMD_TARGET("avx512f")
+    explicit AVX512KeyGroup(const uint32_t* p)
+        : keys(_mm512_load_si512(reinterpret_cast<const void*>(p))) {}
+
+    GROUPED_SIMD_TARGET("avx512f")
+    uint32_t match(uint32_t key) const {
+        return _mm512_cmpeq_epi32_mask(keys, _mm512_set1_epi32(static_cast<int>(key)));
+    }
+};
+
+}  // namespace grouped_simd_detail
+
+template <typename V = uint32_t, typename Hash = std::hash<uint32_t>, typename Allocator = std::allocator<uint8_t>>
+class DirectKeyGroupedSIMD {
+public:
+    static constexpr size_t GROUP_KEYS = 16;  // One 64-byte line
+
+private:
+    static_assert(!std::is_same<V, bool>::value, "DirectKeyGroupedSIMD stores values in std::vector, which packs bool");
+
+    using SSE2KeyGroup = grouped_simd_detail::SSE2KeyGroup;
+    using AVX2KeyGroup = grouped_simd_detail::AVX2KeyGroup;
+    using AVX512KeyGroup = grouped_simd_detail::AVX512KeyGroup;
+
+    struct alignas(64) KeyLine {
+        uint32_t keys[GROUP_KEYS];
+    };
+
+    template <typename T>
+    using Rebind = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    std::vector<KeyLine, Rebind<KeyLine>> lines_;
+    std::vector<V, Rebind<V>> values_;
+    size_t group_mask_ = 0;  // Group count - 1
+    size_t size_ = 0;
+    size_t tombstones_ = 0;
+    size_t max_used_ = 0;    // Live entries plus tombstones allowed before rehashing
+    double delta_;
+    uint64_t salt_;
+    uint32_t empty_key_;
+    uint32_t tombstone_key_;
+    GroupBackend backend_;
+    Hash hasher_;
+
+    uint64_t hash_with_salt(uint32_t key) const {
+        return grouped_simd_detail::hash_with_salt(hasher_, key, salt_);
+    }
+
+    bool reserved(uint32_t key) const {
+        return key == empty_key_ || key == tombstone_key_;
+    }
+
+    uint32_t& key_at(size_t idx) { return lines_[idx / GROUP_KEYS].keys[idx % GROUP_KEYS]; }
+
+    // Slot holding key, or NOT_FOUND. Tombstones never equal a stored key, so
+    // they are probed past; only a group with an empty slot ends the search.
+    template <typename Group>
+    size_t find_impl(uint32_t key, uint64_t h) const {
+        using grouped_simd_detail::lowest_bit;
+        size_t g = h & group_mask_;
+
+        for (size_t j = 1;; ++j) {
+            Group group(lines_[g].keys);
+            uint32_t hit = group.match(key);
+            if (hit != 0) return g * GROUP_KEYS + lowest_bit(hit);
+            if (group.match(empty_key_) != 0 || j > group_mask_) return NOT_FOUND;
+            g = (g + j) & group_mask_;
+        }
+    }
+
+    // As find_impl(), also setting free_idx to the first empty or tombstone
+    // slot in probe order (NOT_FOUND if there is none)
+    template <typename Group>
+    size_t probe_impl(uint32_t key, uint64_t h, size_t& free_idx) const {
+        using grouped_simd_detail::lowest_bit;
+        size_t g = h & group_mask_;
+        free_idx = NOT_FOUND;
+
+        for (size_t j = 1;; ++j) {
+            Group group(lines_[g].keys);
+            uint32_t hit = group.match(key);
+            if (hit != 0) return g * GROUP_KEYS + lowest_bit(hit);
+
+            uint32_t empty = group.match(empty_key_);
+            if (free_idx == NOT_FOUND) {
+                uint32_t free_mask = empty | group.match(tombstone_key_);
+                if (free_mask != 0) free_idx = g * GROUP_KEYS + lowest_bit(free_mask);
+            }
+            if (empty != 0 || j > group_mask_) return NOT_FOUND;
+            g = (g + j) & group_mask_;
+        }
+    }
+
+    GROUPED_SIMD_TARGET_FLATTEN("avx2")
+    size_t find_avx2(uint32_t key, uint64_t h) const {
+        return find_impl<AVX2KeyGroup>(key, h);
+    }
+
+    GROUPED_SIMD_TARGET_FLATTEN("avx2")
+    size_t probe_avx2(uint32_t key, uint64_t h, size_t& free_idx) const {
+        return probe_impl<AVX2KeyGroup>(key, h, free_idx);
+    }
+
+    GROUPED_SIMD_TARGET_FLATTEN("avx512f")
+    size_t find_avx512(uint32_t key, uint64_t h) const {
+        return find_impl<AVX512KeyGroup>(key, h);
+    }
+
+    GROUPED_SIMD_TARGET_FLATTEN("avx512f")
+    size_t probe_avx512(uint32_t key, uint64_t h, size_t& free_idx) const {
+        return probe_impl<AVX512KeyGroup>(key, h, free_idx);
+    }
+
+    size_t find_slot(uint32_t key, uint64_t h) const {
+        switch (backend_) {
+        case GroupBackend::AVX512: return find_avx512(key, h);
+        case GroupBackend::AVX2: return find_avx2(key, h);
+        default: return find_impl<SSE2KeyGroup>(key, h);  // SSE2: the constructor rejects the rest
+        }
+    }
+
+    size_t probe(uint32_t key, uint64_t h, size_t& free_idx) const {
+        switch (backend_) {
+        case GroupBackend::AVX512: return probe_avx512(key, h, free_idx);
+        case GroupBackend::AVX2: return probe_avx2(key, h, free_idx);
+        default: return probe_impl<SSE2KeyGroup>(key, h, free_idx);  // SSE2
+        }
+    }
+
+    void set_capacity(size_t groups) {
+        KeyLine empty;
+        std::fill(std::begin(empty.keys), std::end(empty.keys), empty_key_);
+        lines_.assign(groups, empty);
+        values_.assign(groups * GROUP_KEYS, V());
+        group_mask_ = groups - 1;
+        tombstones_ = 0;
+        max_used_ = static_cast<size_t>(groups * GROUP_KEYS * (1.0 - delta_));
+    }
+
+    // Smallest power-of-two group count holding n entries within the load limit
+    size_t groups_for(size_t n) const {
+        size_t groups = 1;
+        while (static_cast<size_t>(groups * GROUP_KEYS * (1.0 - delta_)) < n) groups <<= 1;
+        return groups;
+    }
+
+    void rehash(size_t groups) {
+        std::vector<KeyLine, Rebind<KeyLine>> old_lines(lines_.get_allocator());
+        std::vector<V, Rebind<V>> old_values(values_.get_allocator());
+        old_lines.swap(lines_);
+        old_values.swap(values_);
+        set_capacity(groups);
+
+        for (size_t idx = 0; idx < old_values.size(); ++idx) {
+            uint32_t key = old_lines[idx / GROUP_KEYS].keys[idx % GROUP_KEYS];
+            if (reserved(key)) continue;
+            size_t free_idx;
+            probe(key, hash_with_salt(key), free_idx);
+            key_at(free_idx) = key;
+            values_[free_idx] = std::move(old_values[idx]);
+        }
+    }
+
+    template <typename... Args>
+    std::pair<V*, bool> try_emplace_impl(uint32_t key, Args&&... args) {
+        if (reserved(key)) throw std::invalid_argument("Key is reserved as the empty or tombstone marker");
+
+        uint64_t h = hash_with_salt(key);
+        size_t free_idx;
+        size_t found = probe(key, h, free_idx);
+        if (found != NOT_FOUND) return {&values_[found], false};
+
+        if (size_ + tombstones_ >= max_used_ || free_idx == NOT_FOUND) {
+            // Mostly tombstones: same size suffices once they are dropped
+            size_t groups = group_mask_ + 1;
+            rehash(size_ + 1 > max_used_ / 2 ? groups * 2 : groups);
+            probe(key, h, free_idx);
+        }
+
+        if (key_at(free_idx) == tombstone_key_) --tombstones_;
+        key_at(free_idx) = key;
+        values_[free_idx] = V(std::forward<Args>(args)...);
+        ++size_;
+        return {&values_[free_idx], true};
+    }
+
+public:
+    // capacity is in entries, rounded up to a power-of-two number of groups;
+    // delta is 1 - max load factor, as in GroupedSIMDElastic. empty_key and
+    // empty_key - 1 are reserved and cannot be inserted. Throws
+    // std::invalid_argument for GroupBackend::SWAR, which has no key kernel.
+    explicit DirectKeyGroupedSIMD(size_t capacity, double delta = 0.1, GroupBackend backend = GroupBackend::Auto,
+                                  uint32_t empty_key = UINT32_MAX, const Allocator& alloc = Allocator())
+        : lines_(Rebind<KeyLine>(alloc)), values_(Rebind<V>(alloc)), delta_(delta),
+          empty_key_(empty_key), tombstone_key_(empty_key - 1)
+    {
+        if (delta <= 0 || delta >= 1) throw std::invalid_argument("Delta must be in (0,1)");
+        if (backend == GroupBackend::Auto) backend = grouped_simd_detail::best_backend();
+        if (!grouped_simd_detail::cpu_supports(backend)) {
+            throw std::invalid_argument("Group backend not supported by this CPU");
+        }
+        // Keys are scanned four bytes a lane: there is no SWAR key group
+        if (backend != GroupBackend::SSE2 && backend != GroupBackend::AVX2 && backend != GroupBackend::AVX512) {
+            throw std::invalid_argument("DirectKeyGroupedSIMD: no key-group kernel for this backend");
+        }
+        backend_ = backend;
+        set_capacity(groups_for(capacity > 0 ? capacity : 1));
+
+        std::random_device rd;
+        salt_ = rd();
+    }
+
+    // Insert or update; true if key was new. Throws std::invalid_argument
+    // for a reserved key.
+    bool insert(uint32_t key, const V& value) {
+        auto r = try_emplace_impl(key, value);
+        if (!r.second) *r.first = value;
+        return r.second;
+    }
+
+    // Insert V(args...) if key is absent; {value, inserted}
+    template <typename... Args>
+    std::pair<V*, bool> try_emplace(uint32_t key, Args&&... args) {
+        return try_emplace_impl(key, std::forward<Args>(args)...);
+    }
+
+    V* find(uint32_t key) {
+        return const_cast<V*>(static_cast<const DirectKeyGroupedSIMD*>(this)->find(key));
+    }
+
+    const V* find(uint32_t key) const {
+        // A reserved key would match free slots
+        if (reserved(key)) return nullptr;
+        size_t found = find_slot(key, hash_with_salt(key));
+        return found == NOT_FOUND ? nullptr : &values_[found];
+    }
+
+    bool contains(uint32_t key) const {
+        return find(key) != nullptr;
+    }
+
+    // A group that still has an empty slot was never full, so no probe
+    // passed through it and the slot can be emptied; otherwise it becomes a
+    // tombstone
+    bool erase(uint32_t key) {
+        if (reserved(key)) return false;
+        size_t found = find_slot(key, hash_with_salt(key));
+        if (found == NOT_FOUND) return false;
+
+        bool group_has_empty = SSE2KeyGroup(lines_[found / GROUP_KEYS].keys).match(empty_key_) != 0;
+        key_at(found) = group_has_empty ? empty_key_ : tombstone_key_;
+        if (!group_has_empty) ++tombstones_;
+        values_[found] = V();
+        --size_;
+        return true;
+    }
+
+    V& operator[](uint32_t key) {
+        return *try_emplace(key).first;
+    }
+
+    // Grow now so that n entries fit without further rehashing
+    void reserve(size_t n) {
+        size_t groups = groups_for(n);
+        if (groups > group_mask_ + 1) rehash(groups);
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return (group_mask_ + 1) * GROUP_KEYS; }
+    double load_factor() const { return static_cast<double>(size_) / capacity(); }
+    size_t group_count() const { return group_mask_ + 1; }
+    GroupBackend backend() const { return backend_; }
+    uint32_t empty_key() const { return empty_key_; }
+};
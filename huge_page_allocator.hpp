@@ -0,0 +1,132 @@
+/**
+ * Huge Page Allocator
+ * ===================
+ *
+ * Allocator for GroupedSIMDElastic's Allocator parameter that backs large
+ * arrays with 2MB pages. Random lookups in a table of tens of millions of
+ * entries touch a new 4KB page on almost every probe, and the TLB covers
+ * only a few MB of 4KB pages; with 2MB pages the same TLB reach covers GBs.
+ *
+ * Allocations of at least HUGE_PAGE_SIZE bytes are tried in order:
+ * - Linux: MAP_HUGETLB, from the pool reserved in /proc/sys/vm/nr_hugepages
+ *   (guaranteed 2MB pages, fails fast when nothing is reserved)
+ * - Linux: a 2MB-aligned anonymous mapping with madvise(MADV_HUGEPAGE), so
+ *   transparent huge pages apply when THP is in "madvise" or "always" mode
+ * - Windows: VirtualAlloc with MEM_LARGE_PAGES (needs SeLockMemoryPrivilege),
+ *   then plain VirtualAlloc
+ * - Elsewhere: a plain anonymous mapping
+ * Each step falls back to the next, so the allocator always works and at
+ * worst behaves like the default one. Smaller allocations use operator new.
+ *
+ * Stateless: all instances compare equal.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+namespace grouped_simd_detail {
+
+constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+inline size_t huge_page_round(size_t bytes) {
+    return (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+}
+
+// bytes is a multiple of HUGE_PAGE_SIZE; returns nullptr when out of memory
+inline void* huge_page_map(size_t bytes) {
+    #ifdef _WIN32
+        SIZE_T large = GetLargePageMinimum();
+        if (large != 0 && bytes % large == 0) {
+            void* p = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (p) return p;
+        }
+        return VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    #else
+        #ifdef MAP_HUGETLB
+            void* hugetlb = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (hugetlb != MAP_FAILED) return hugetlb;
+        #endif
+
+        // Over-map by one huge page and trim, so the range starts on a 2MB
+        // boundary and THP can back all of it
+        size_t padded = bytes + HUGE_PAGE_SIZE;
+        void* raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) return nullptr;
+
+        uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+        uintptr_t aligned = (start + HUGE_PAGE_SIZE - 1) & ~static_cast<uintptr_t>(HUGE_PAGE_SIZE - 1);
+        if (aligned > start) munmap(raw, aligned - start);
+        size_t tail = (start + padded) - (aligned + bytes);
+        if (tail > 0) munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+
+        void* p = reinterpret_cast<void*>(aligned);
+        #ifdef MADV_HUGEPAGE
+            madvise(p, bytes, MADV_HUGEPAGE);  // Advisory: failure leaves 4KB pages
+        #endif
+        return p;
+    #endif
+}
+
+inline void huge_page_unmap(void* p, size_t bytes) {
+    #ifdef _WIN32
+        (void)bytes;
+        VirtualFree(p, 0, MEM_RELEASE);
+    #else
+        munmap(p, bytes);
+    #endif
+}
+
+}  // namespace grouped_simd_detail
+
+template <typename T>
+class HugePageAllocator {
+public:
+    using value_type = T;
+
+    HugePageAllocator() noexcept = default;
+
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        using namespace grouped_simd_detail;
+        if (n > SIZE_MAX / sizeof(T)) throw std::bad_array_new_length();
+        size_t bytes = n * sizeof(T);
+        if (bytes < HUGE_PAGE_SIZE) {
+            return static_cast<T*>(::operator new(bytes, std::align_val_t(alignof(T))));
+        }
+
+        void* p = huge_page_map(huge_page_round(bytes));
+        if (!p) throw std::bad_alloc();
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        using namespace grouped_simd_detail;
+        size_t bytes = n * sizeof(T);
+        if (bytes < HUGE_PAGE_SIZE) {
+            ::operator delete(p, std::align_val_t(alignof(T)));
+        } else {
+            huge_page_unmap(p, huge_page_round(bytes));
+        }
+    }
+
+    template <typename U>
+    bool operator==(const HugePageAllocator<U>&) const noexcept { return true; }
+
+    template <typename U>
+    bool operator!=(const HugePageAllocator<U>&) const noexcept { return false; }
+};
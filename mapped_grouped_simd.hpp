@@ -0,0 +1,296 @@
+/**
+ * Memory-Mapped Grouped SIMD Hash Table
+ * =====================================
+ *
+ * Read-only view of a table written by GroupedSIMDElastic::save(). The file
+ * is mapped as is and find() probes the mapping directly: opening costs one
+ * mmap() and a header check, with no deserialization, so a cold start is
+ * bound by page faults on the groups actually probed instead of by a
+ * rebuild.
+ *
+ * - Sections are page aligned in the file, so the metadata keeps the 64-byte
+ *   alignment the AVX-512 kernel loads with
+ * - The stored salt and group width reproduce the writer's probe sequences;
+ *   the group width selects the kernel, so the CPU must support the writer's
+ *   backend (save from a GroupBackend::SSE2 table for files any x86 can
+ *   read, or GroupBackend::SWAR for any CPU)
+ * - K and V must be trivially copyable, and Hash must give the same values
+ *   as in the writer
+ *
+ * The mapping is private and read-only; pointers returned by find() stay
+ * valid for the lifetime of the view. POSIX mmap, or a file mapping on
+ * Windows.
+ */
+
+#pragma once
+
+#include "grouped_simd_elastic.hpp"
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class MappedGroupedSIMD {
+public:
+    // Same layout as GroupedSIMDElastic::Entry, which the file stores
+    struct Entry {
+        K key;
+        V value;
+    };
+
+    static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+                  "MappedGroupedSIMD reads entries as raw bytes: K and V must be trivially copyable");
+
+private:
+    using FileHeader = grouped_simd_detail::FileHeader;
+    using SSE2Group = grouped_simd_detail::SSE2Group;
+    using AVX2Group = grouped_simd_detail::AVX2Group;
+    using AVX512Group = grouped_simd_detail::AVX512Group;
+    using SWARGroup = grouped_simd_detail::SWARGroup;
+
+    static constexpr uint8_t EMPTY = 0x00;
+
+    const char* mapping_ = nullptr;
+    size_t mapping_bytes_ = 0;
+    #ifdef _WIN32
+        HANDLE file_ = INVALID_HANDLE_VALUE;
+        HANDLE map_ = nullptr;
+    #endif
+
+    const uint8_t* metadata_ = nullptr;
+    const uint8_t* overflow_ = nullptr;
+    const Entry* table_ = nullptr;
+    size_t capacity_ = 0;
+    size_t mask_ = 0;
+    size_t size_ = 0;
+    size_t max_group_used_ = 0;
+    uint64_t salt_ = 0;
+    double delta_ = 0;
+    GroupBackend backend_ = GroupBackend::SSE2;
+    size_t group_size_ = 0;
+    Hash hasher_;
+    KeyEqual key_equal_;
+
+    // The writer's hash and probe sequence: same helpers, stored salt
+    uint64_t hash_with_salt(const K& key) const {
+        return grouped_simd_detail::hash_with_salt(hasher_, key, salt_);
+    }
+
+    template <typename Group>
+    size_t group_base(uint64_t h, size_t group_idx) const {
+        return grouped_simd_detail::group_base<Group>(h, group_idx, capacity_, mask_);
+    }
+
+    size_t slot_in_group(size_t base, size_t offset) const {
+        size_t idx = base + offset;
+        return (idx >= capacity_) ? idx - capacity_ : idx;
+    }
+
+    // GroupedSIMDElastic::find_index_impl() over the mapped arrays
+    template <typename Group>
+    const Entry* find_impl(const K& key, uint64_t h) const {
+        using grouped_simd_detail::lowest_bit;
+        uint8_t meta = grouped_simd_detail::make_metadata(h);
+        size_t groups_to_check = max_group_used_ + 1;
+
+        for (size_t g = 0; g < groups_to_check; ++g) {
+            size_t base = group_base<Group>(h, g);
+            Group group(metadata_ + base);
+
+            auto match_mask = group.match(meta);
+            while (match_mask != 0) {
+                size_t idx = slot_in_group(base, lowest_bit(match_mask));
+                if (key_equal_(table_[idx].key, key)) {
+                    return &table_[idx];
+                }
+                match_mask &= (match_mask - 1);
+            }
+
+            if (group.match(EMPTY) != 0 || overflow_[base / Group::WIDTH] == 0) {
+                return nullptr;
+            }
+        }
+
+        return nullptr;
+    }
+
+    GROUPED_SIMD_TARGET_FLATTEN("avx2")
+    const Entry* find_avx2(const K& key, uint64_t h) const {
+        return find_impl<AVX2Group>(key, h);
+    }
+
+    GROUPED_SIMD_TARGET_FLATTEN("avx512f,avx512bw")
+    const Entry* find_avx512(const K& key, uint64_t h) const {
+        return find_impl<AVX512Group>(key, h);
+    }
+
+    [[noreturn]] void fail(const std::string& path, const char* what) {
+        unmap();
+        throw std::runtime_error("MappedGroupedSIMD: " + path + ": " + what);
+    }
+
+    void map_file(const std::string& path, bool populate) {
+        #ifdef _WIN32
+            (void)populate;
+            file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+            if (file_ == INVALID_HANDLE_VALUE) fail(path, "cannot open");
+            LARGE_INTEGER file_size;
+            if (!GetFileSizeEx(file_, &file_size)) fail(path, "cannot stat");
+            mapping_bytes_ = static_cast<size_t>(file_size.QuadPart);
+            if (mapping_bytes_ < sizeof(FileHeader)) fail(path, "truncated header");
+            map_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!map_) fail(path, "cannot map");
+            mapping_ = static_cast<const char*>(MapViewOfFile(map_, FILE_MAP_READ, 0, 0, 0));
+            if (!mapping_) fail(path, "cannot map");
+        #else
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) fail(path, "cannot open");
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                fail(path, "cannot stat");
+            }
+            mapping_bytes_ = static_cast<size_t>(st.st_size);
+            if (mapping_bytes_ < sizeof(FileHeader)) {
+                ::close(fd);
+                fail(path, "truncated header");
+            }
+
+            int flags = MAP_PRIVATE;
+            #ifdef MAP_POPULATE
+                if (populate) flags |= MAP_POPULATE;
+            #else
+                (void)populate;
+            #endif
+            void* p = ::mmap(nullptr, mapping_bytes_, PROT_READ, flags, fd, 0);
+            ::close(fd);  // The mapping keeps its own reference
+            if (p == MAP_FAILED) fail(path, "cannot map");
+            mapping_ = static_cast<const char*>(p);
+        #endif
+    }
+
+    void unmap() {
+        #ifdef _WIN32
+            if (mapping_) UnmapViewOfFile(mapping_);
+            if (map_) CloseHandle(map_);
+            if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+            map_ = nullptr;
+            file_ = INVALID_HANDLE_VALUE;
+        #else
+            if (mapping_) ::munmap(const_cast<char*>(mapping_), mapping_bytes_);
+        #endif
+        mapping_ = nullptr;
+        mapping_bytes_ = 0;
+    }
+
+public:
+    // Map the file at path. populate pre-faults the whole mapping (Linux
+    // MAP_POPULATE) for steady lookup latency from the first call, at the
+    // price of reading the file at open. Throws std::runtime_error if the
+    // file is missing, truncated or was written for another K/V layout,
+    // byte order or format version, and std::invalid_argument if this CPU
+    // lacks the writer's group kernel.
+    explicit MappedGroupedSIMD(const std::string& path, bool populate = false) {
+        using namespace grouped_simd_detail;
+        map_file(path, populate);
+
+        FileHeader header;
+        std::memcpy(&header, mapping_, sizeof(header));
+        if (std::memcmp(header.magic, FILE_MAGIC, sizeof(header.magic)) != 0) fail(path, "not a table file");
+        if (header.byte_order != FILE_BYTE_ORDER) fail(path, "written with the other byte order");
+        if (header.version != FILE_VERSION) fail(path, "unsupported format version");
+        if (header.key_size != sizeof(K) || header.value_size != sizeof(V) || header.entry_size != sizeof(Entry)) {
+            fail(path, "written for another key/value layout");
+        }
+
+        // Sections in bounds; the metadata needs its mirrored tail. A
+        // capacity past the file size is corrupt, which also keeps the sums
+        // and products below from wrapping. mask is 0, or capacity - 1 of a
+        // power-of-two capacity.
+        auto in_file = [&](uint64_t offset, uint64_t bytes) {
+            return offset % FILE_ALIGNMENT == 0 && offset <= mapping_bytes_ && bytes <= mapping_bytes_ - offset;
+        };
+        if (!in_file(header.metadata_offset, header.metadata_bytes) ||
+            !in_file(header.overflow_offset, header.overflow_bytes) ||
+            !in_file(header.entries_offset, header.entries_bytes) ||
+            header.capacity == 0 ||
+            header.capacity > mapping_bytes_ ||
+            (header.mask != 0 &&
+             ((header.capacity & (header.capacity - 1)) != 0 || header.mask != header.capacity - 1)) ||
+            header.metadata_bytes < header.capacity + 63 ||
+            header.capacity > UINT64_MAX / sizeof(Entry) ||
+            header.entries_bytes != header.capacity * sizeof(Entry) ||
+            header.group_size == 0 ||
+            header.overflow_bytes != (header.capacity + header.group_size - 1) / header.group_size) {
+            fail(path, "truncated or corrupt");
+        }
+
+        // Width -> backend. Not a switch: off x86 the wide kernel names
+        // alias SWARGroup and share its width.
+        if (header.group_size == SWARGroup::WIDTH) {
+            backend_ = GroupBackend::SWAR;
+        } else if (header.group_size == 16) {
+            backend_ = GroupBackend::SSE2;
+        } else if (header.group_size == 32) {
+            backend_ = GroupBackend::AVX2;
+        } else if (header.group_size == 64) {
+            backend_ = GroupBackend::AVX512;
+        } else {
+            fail(path, "unknown group width");
+        }
+        if (!cpu_supports(backend_)) {
+            unmap();
+            throw std::invalid_argument("MappedGroupedSIMD: " + path + ": group backend not supported by this CPU");
+        }
+
+        metadata_ = reinterpret_cast<const uint8_t*>(mapping_ + header.metadata_offset);
+        overflow_ = reinterpret_cast<const uint8_t*>(mapping_ + header.overflow_offset);
+        table_ = reinterpret_cast<const Entry*>(mapping_ + header.entries_offset);
+        capacity_ = header.capacity;
+        mask_ = header.mask;
+        size_ = header.size;
+        max_group_used_ = header.max_group_used;
+        salt_ = header.salt;
+        delta_ = header.delta;
+        group_size_ = header.group_size;
+    }
+
+    ~MappedGroupedSIMD() { unmap(); }
+
+    MappedGroupedSIMD(const MappedGroupedSIMD&) = delete;
+    MappedGroupedSIMD& operator=(const MappedGroupedSIMD&) = delete;
+
+    const V* find(const K& key) const {
+        uint64_t h = hash_with_salt(key);
+        const Entry* e;
+        switch (backend_) {
+        case GroupBackend::AVX512: e = find_avx512(key, h); break;
+        case GroupBackend::AVX2: e = find_avx2(key, h); break;
+        case GroupBackend::SWAR: e = find_impl<SWARGroup>(key, h); break;
+        default: e = find_impl<SSE2Group>(key, h); break;
+        }
+        return e ? &e->value : nullptr;
+    }
+
+    bool contains(const K& key) const {
+        return find(key) != nullptr;
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    double load_factor() const { return static_cast<double>(size_) / capacity_; }
+    double delta() const { return delta_; }
+    size_t max_group_used() const { return max_group_used_; }
+    GroupBackend backend() const { return backend_; }
+    size_t group_size() const { return group_size_; }
+};
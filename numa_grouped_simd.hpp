@@ -0,0 +1,252 @@
+/**
+ * NUMA-Aware Grouped SIMD Tables
+ * ==============================
+ *
+ * A table's pages land on the NUMA node of the thread that first touches
+ * them, and the constructor zero-fills everything on one thread: the whole
+ * table ends up on one socket and lookups from the other pay the remote
+ * latency. Two remedies, both on raw mbind()/get_mempolicy() system calls
+ * (no libnuma needed):
+ *
+ * - NumaAllocator<T>(): interleaves a table's pages round-robin across all
+ *   nodes, so every socket sees the same mix of local and remote accesses.
+ *   NumaAllocator<T>(node) binds them to one node instead.
+ * - NumaReplicatedGroupedSIMD: one read-only GroupedSIMDElastic per node,
+ *   each bound to its node; find() queries the replica local to the CPU the
+ *   calling thread runs on. Costs one copy of the table per node.
+ *
+ * The policy is set on fresh mappings before first touch, so it holds
+ * whichever thread initializes the memory. Arrays below 2MB and non-Linux
+ * systems get plain allocations; everything still works on one node.
+ */
+
+#pragma once
+
+#include "grouped_simd_elastic.hpp"
+#include "huge_page_allocator.hpp"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+    #include <sched.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace grouped_simd_detail {
+
+// From <linux/mempolicy.h>, which not every toolchain ships
+constexpr int NUMA_MPOL_BIND = 2;
+constexpr int NUMA_MPOL_INTERLEAVE = 3;
+constexpr unsigned NUMA_MPOL_F_NODE = 1u << 0;
+constexpr unsigned NUMA_MPOL_F_ADDR = 1u << 1;
+
+// "0-3,8,10-11" (the sysfs list format) -> {0,1,2,3,8,10,11}
+inline std::vector<int> parse_id_list(const std::string& list) {
+    std::vector<int> ids;
+    size_t pos = 0;
+    while (pos < list.size()) {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos) end = list.size();
+        std::string range = list.substr(pos, end - pos);
+        size_t dash = range.find('-');
+        try {
+            int lo = std::stoi(range.substr(0, dash));
+            int hi = dash == std::string::npos ? lo : std::stoi(range.substr(dash + 1));
+            for (int id = lo; id <= hi; ++id) ids.push_back(id);
+        } catch (const std::exception&) {
+            // Blank or malformed entry: skip it
+        }
+        pos = end + 1;
+    }
+    return ids;
+}
+
+// Online nodes and the node of every CPU, read once from sysfs. One node 0
+// holding every CPU where sysfs is unavailable.
+struct NumaTopology {
+    std::vector<int> nodes;
+    std::vector<int> cpu_node;  // Indexed by CPU number
+
+    static const NumaTopology& instance() {
+        static const NumaTopology topology;
+        return topology;
+    }
+
+private:
+    NumaTopology() {
+        std::string online;
+        std::ifstream("/sys/devices/system/node/online") >> online;
+        nodes = parse_id_list(online);
+        if (nodes.empty()) nodes.push_back(0);
+
+        for (int node : nodes) {
+            std::string cpus;
+            std::ifstream("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist") >> cpus;
+            for (int cpu : parse_id_list(cpus)) {
+                if (cpu >= static_cast<int>(cpu_node.size())) cpu_node.resize(cpu + 1, nodes.front());
+                cpu_node[cpu] = node;
+            }
+        }
+    }
+};
+
+// Node of the CPU this thread is running on right now. Threads can
+// migrate, so it is a hint: good for picking a local copy, not for
+// correctness.
+inline int current_numa_node() {
+    #ifdef __linux__
+        const NumaTopology& topology = NumaTopology::instance();
+        int cpu = sched_getcpu();
+        if (cpu >= 0 && cpu < static_cast<int>(topology.cpu_node.size())) return topology.cpu_node[cpu];
+        return topology.nodes.front();
+    #else
+        return 0;
+    #endif
+}
+
+// Node holding the page at p (faulting it in if needed); -1 if unknown
+inline int numa_node_of(const void* p) {
+    #if defined(__linux__) && defined(SYS_get_mempolicy)
+        int node = -1;
+        if (syscall(SYS_get_mempolicy, &node, nullptr, 0UL, const_cast<void*>(p),
+                    NUMA_MPOL_F_NODE | NUMA_MPOL_F_ADDR) != 0) {
+            return -1;
+        }
+        return node;
+    #else
+        (void)p;
+        return -1;
+    #endif
+}
+
+// Apply a placement policy to [p, p + bytes) before anything touches it.
+// node < 0 interleaves across all online nodes. Advisory: on failure (no
+// NUMA support, one node) the kernel's default first-touch policy remains.
+inline void numa_place(void* p, size_t bytes, int node) {
+    #if defined(__linux__) && defined(SYS_mbind)
+        const NumaTopology& topology = NumaTopology::instance();
+        int highest = node;
+        for (int n : topology.nodes) highest = std::max(highest, n);
+
+        std::vector<unsigned long> mask(highest / (8 * sizeof(unsigned long)) + 1, 0);
+        auto set = [&](int n) { mask[n / (8 * sizeof(unsigned long))] |= 1UL << (n % (8 * sizeof(unsigned long))); };
+        if (node < 0) {
+            for (int n : topology.nodes) set(n);
+        } else {
+            set(node);
+        }
+
+        int mode = node < 0 ? NUMA_MPOL_INTERLEAVE : NUMA_MPOL_BIND;
+        syscall(SYS_mbind, p, bytes, mode, mask.data(), static_cast<unsigned long>(highest + 2), 0U);
+    #else
+        (void)p;
+        (void)bytes;
+        (void)node;
+    #endif
+}
+
+}  // namespace grouped_simd_detail
+
+// Allocator placing large arrays on NUMA nodes: interleaved across all nodes
+// by default, or bound to one. The mapping also gets 2MB pages where
+// HugePageAllocator would (placement is per page, so interleaving happens
+// in 2MB steps then).
+template <typename T>
+class NumaAllocator {
+    template <typename U> friend class NumaAllocator;
+    int node_ = -1;  // -1: interleave
+
+public:
+    using value_type = T;
+
+    NumaAllocator() noexcept = default;
+    explicit NumaAllocator(int node) noexcept : node_(node) {}
+
+    template <typename U>
+    NumaAllocator(const NumaAllocator<U>& other) noexcept : node_(other.node_) {}
+
+    T* allocate(size_t n) {
+        using namespace grouped_simd_detail;
+        if (n > SIZE_MAX / sizeof(T)) throw std::bad_array_new_length();
+        size_t bytes = n * sizeof(T);
+        if (bytes < HUGE_PAGE_SIZE) {
+            return static_cast<T*>(::operator new(bytes, std::align_val_t(alignof(T))));
+        }
+
+        size_t mapped = huge_page_round(bytes);
+        void* p = huge_page_map(mapped);
+        if (!p) throw std::bad_alloc();
+        numa_place(p, mapped, node_);
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        using namespace grouped_simd_detail;
+        size_t bytes = n * sizeof(T);
+        if (bytes < HUGE_PAGE_SIZE) {
+            ::operator delete(p, std::align_val_t(alignof(T)));
+        } else {
+            huge_page_unmap(p, huge_page_round(bytes));
+        }
+    }
+
+    int node() const noexcept { return node_; }
+
+    template <typename U>
+    bool operator==(const NumaAllocator<U>& other) const noexcept { return node_ == other.node_; }
+
+    template <typename U>
+    bool operator!=(const NumaAllocator<U>& other) const noexcept { return node_ != other.node_; }
+};
+
+// Read-replicated table: the same keys and values in one GroupedSIMDElastic
+// per NUMA node, each bound to its node. find() goes to the replica of the
+// node the caller is running on, so no lookup crosses the interconnect.
+// Read-only after construction; concurrent find() calls are safe (the const
+// lookup never migrates). Rebuild it to change the contents.
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class NumaReplicatedGroupedSIMD {
+public:
+    using Table = GroupedSIMDElastic<K, V, Hash, KeyEqual, NumaAllocator<uint8_t>>;
+
+private:
+    std::vector<Table> replicas_;
+    std::vector<size_t> replica_of_node_;  // Indexed by node id
+
+    const Table& local() const {
+        size_t node = static_cast<size_t>(grouped_simd_detail::current_numa_node());
+        return replicas_[node < replica_of_node_.size() ? replica_of_node_[node] : 0];
+    }
+
+public:
+    // Build one replica per online node from keys[i] -> values[i], with the
+    // arguments of GroupedSIMDElastic::build()
+    NumaReplicatedGroupedSIMD(const K* keys, const V* values, size_t n, size_t threads = 0,
+                              double delta = 0.1, bool power_of_two = false,
+                              GroupBackend backend = GroupBackend::Auto)
+    {
+        const auto& topology = grouped_simd_detail::NumaTopology::instance();
+        replicas_.reserve(topology.nodes.size());
+        for (int node : topology.nodes) {
+            if (node >= static_cast<int>(replica_of_node_.size())) replica_of_node_.resize(node + 1, 0);
+            replica_of_node_[node] = replicas_.size();
+            replicas_.push_back(Table::build(keys, values, n, threads, delta, power_of_two, backend,
+                                             NumaAllocator<uint8_t>(node)));
+        }
+    }
+
+    const V* find(const K& key) const {
+        return local().find(key);
+    }
+
+    bool contains(const K& key) const {
+        return local().contains(key);
+    }
+
+    size_t size() const { return replicas_.front().size(); }
+    size_t replicas() const { return replicas_.size(); }
+    const Table& replica(size_t i) const { return replicas_[i]; }
+};
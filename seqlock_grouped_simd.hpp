@@ -0,0 +1,456 @@
+/**
+ * Seqlock Grouped SIMD Hash Table
+ * ===============================
+ *
+ * Read-mostly concurrent table: lookups take no lock and write no shared
+ * memory; writers are serialized by one mutex.
+ *
+ * Every 64-slot block (one metadata cache line) has a version counter that
+ * a writer makes odd while it changes any slot of the block and even again
+ * when done. A lookup, per group:
+ * 1. Reads the versions of the one or two blocks the group covers
+ * 2. SIMD-scans the group and copies out the candidate entries
+ * 3. Re-reads the versions; if any changed (or was odd), retries that group
+ *
+ * Capacity is rounded up to a multiple of 64, so a group of any backend
+ * covers at most two blocks: the one holding its base and the one holding
+ * its last slot (block 0 when it wraps into the mirrored tail).
+ *
+ * Tombstone cleanup rewrites the whole table in place under a table-wide
+ * version, and lookups wait while it is odd. It runs only when the caller
+ * asks (cleanup_tombstones()): inserts reuse tombstones, so they only make
+ * misses probe further and never fill the table.
+ *
+ * Because lookups may read entries mid-write before discarding the copy,
+ * K and V must be trivially copyable. Capacity is fixed.
+ */
+
+#pragma once
+
+#include "concurrent_grouped_simd.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class SeqlockGroupedSIMD {
+    static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+                  "Optimistic readers copy entries that may be mid-write: K and V must be trivially copyable");
+
+public:
+    struct Entry {
+        K key;
+        V value;
+    };
+
+private:
+    using MetadataLine = grouped_simd_detail::MetadataLine;
+    using SSE2Group = grouped_simd_detail::SSE2Group;
+    using AVX2Group = grouped_simd_detail::AVX2Group;
+    using AVX512Group = grouped_simd_detail::AVX512Group;
+    using SWARGroup = grouped_simd_detail::AtomicSWARGroup;  // Scans race writers
+
+    static constexpr double C = 4.0;
+    static constexpr size_t MAX_GROUP_SIZE = 64;
+    static constexpr size_t MIRROR_SIZE = MAX_GROUP_SIZE - 1;
+    static constexpr size_t BLOCK_SIZE = 64;  // Slots per version counter
+    static constexpr uint8_t EMPTY = 0x00;
+    static constexpr uint8_t DELETED = 0x01;
+    static constexpr uint8_t OCCUPIED_BIT = grouped_simd_detail::OCCUPIED_BIT;
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    std::vector<MetadataLine> lines_;
+    std::vector<Entry> table_;
+    std::unique_ptr<std::atomic<uint32_t>[]> versions_;  // One per block
+    std::atomic<uint32_t> table_version_{0};  // Odd during cleanup_tombstones()
+    std::atomic<size_t> max_group_used_{0};
+    size_t capacity_;
+    size_t mask_;  // capacity_ - 1 in power-of-two mode, else 0
+    size_t max_inserts_;
+    size_t total_groups_;
+    std::atomic<size_t> size_{0};
+    size_t tombstones_ = 0;  // Under writer_lock_
+    uint64_t salt_;
+    Hash hasher_;
+    KeyEqual key_equal_;
+    GroupBackend backend_;
+    size_t group_size_;
+    mutable std::mutex writer_lock_;
+
+    uint8_t* metadata() { return lines_.front().bytes; }
+    const uint8_t* metadata() const { return lines_.front().bytes; }
+
+    uint64_t hash_with_salt(const K& key) const {
+        return grouped_simd_detail::hash_with_salt(hasher_, key, salt_);
+    }
+
+    template <typename Group>
+    size_t group_base(uint64_t h, size_t group_idx) const {
+        return grouped_simd_detail::group_base<Group>(h, group_idx, capacity_, mask_);
+    }
+
+    size_t slot_in_group(size_t base, size_t offset) const {
+        size_t idx = base + offset;
+        return (idx >= capacity_) ? idx - capacity_ : idx;
+    }
+
+    // Writer side. Metadata stores are atomic byte stores so that a reader's
+    // SIMD load sees each byte either old or new.
+    void set_metadata(size_t idx, uint8_t m) {
+        grouped_simd_detail::store_release(metadata() + idx, m);
+        if (idx < MIRROR_SIZE) grouped_simd_detail::store_release(metadata() + capacity_ + idx, m);
+    }
+
+    void begin_write(std::atomic<uint32_t>& version) {
+        version.store(version.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void end_write(std::atomic<uint32_t>& version) {
+        version.store(version.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Slot holding key, or the earliest free slot on its sequence (found =
+    // false), or NOT_FOUND. Writers only: no validation needed.
+    template <typename Group>
+    size_t probe_impl(const K& key, uint64_t h, bool& found, size_t& group) const {
+        using grouped_simd_detail::lowest_bit;
+        uint8_t meta = grouped_simd_detail::make_metadata(h);
+        size_t max_used = max_group_used_.load(std::memory_order_relaxed);
+        size_t free_idx = NOT_FOUND;
+        found = false;
+        group = 0;
+
+        for (size_t g = 0; g < total_groups_; ++g) {
+            if (g > max_used && free_idx != NOT_FOUND) break;
+
+            size_t base = group_base<Group>(h, g);
+            Group grp(metadata() + base);
+
+            auto match_mask = grp.match(meta);
+            while (match_mask != 0) {
+                size_t idx = slot_in_group(base, lowest_bit(match_mask));
+                if (key_equal_(table_[idx].key, key)) {
+                    found = true;
+                    group = g;
+                    return idx;
+                }
+                match_mask &= (match_mask - 1);
+            }
+
+            auto free_mask = grp.match_free();
+            if (free_idx == NOT_FOUND && free_mask != 0) {
+                free_idx = slot_in_group(base, lowest_bit(free_mask));
+                group = g;
+            }
+
+            if (grp.match(EMPTY) != 0) break;
+        }
+
+        return free_idx;
+    }
+
+    template <typename Group>
+    size_t find_free_impl(uint64_t h, size_t& group) const {
+        using grouped_simd_detail::lowest_bit;
+        for (size_t g = 0; g < total_groups_; ++g) {
+            size_t base = group_base<Group>(h, g);
+            auto free_mask = Group(metadata() + base).match_free();
+            if (free_mask != 0) {
+                group = g;
+                return slot_in_group(base, lowest_bit(free_mask));
+            }
+        }
+        return NOT_FOUND;
+    }
+
+    // Reader side: copy out key's value, validating every group against its
+    // block versions. Returns false, leaving out untouched, if absent.
+    template <typename Group>
+    bool find_impl(const K& key, uint64_t h, V& out) const {
+        using grouped_simd_detail::lowest_bit;
+        uint8_t meta = grouped_simd_detail::make_metadata(h);
+        size_t groups_to_check = max_group_used_.load(std::memory_order_acquire) + 1;
+        V value;  // May be torn until the versions check out
+
+        for (size_t g = 0; g < groups_to_check; ++g) {
+            size_t base = group_base<Group>(h, g);
+            const std::atomic<uint32_t>& first = versions_[base / BLOCK_SIZE];
+            const std::atomic<uint32_t>& last = versions_[slot_in_group(base, Group::WIDTH - 1) / BLOCK_SIZE];
+
+            for (;;) {
+                uint32_t v1 = first.load(std::memory_order_acquire);
+                uint32_t v2 = last.load(std::memory_order_acquire);
+                if ((v1 | v2) & 1) {
+                    grouped_simd_detail::cpu_relax();
+                    continue;
+                }
+
+                Group group(metadata() + base);
+                bool hit = false;
+                auto match_mask = group.match(meta);
+                while (match_mask != 0) {
+                    Entry copy;
+                    std::memcpy(static_cast<void*>(&copy), &table_[slot_in_group(base, lowest_bit(match_mask))],
+                                sizeof(Entry));
+                    if (key_equal_(copy.key, key)) {
+                        value = copy.value;
+                        hit = true;
+                        break;
+                    }
+                    match_mask &= (match_mask - 1);
+                }
+                bool has_empty = group.match(EMPTY) != 0;
+
+                // Everything read above must be ordered before the re-check
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (first.load(std::memory_order_relaxed) != v1 ||
+                    last.load(std::memory_order_relaxed) != v2) {
+                    continue;
+                }
+
+                if (hit) {
+                    out = value;
+                    return true;
+                }
+                if (has_empty) return false;
+                break;
+            }
+        }
+
+        return false;
+    }
+
+    size_t probe(const K& key, uint64_t h, bool& found, size_t& group) const {
+        switch (backend_) {
+        case GroupBackend::AVX512: return probe_avx512(key, h, found, group);
+        case GroupBackend::AVX2: return probe_avx2(key, h, found, group);
+        case GroupBackend::SWAR: return probe_impl<SWARGroup>(key, h, found, group);
+        default: return probe_impl<SSE2Group>(key, h, found, group);
+        }
+    }
+
+    size_t find_free(uint64_t h, size_t& group) const {
+        switch (backend_) {
+        case GroupBackend::AVX512: return find_free_avx512(h, group);
+        case GroupBackend::AVX2: return find_free_avx2(h, group);
+        case GroupBackend::SWAR: return find_free_impl<SWARGroup>(h, group);
+        default: return find_free_impl<SSE2Group>(h, group);
+        }
+    }
+
+    GROUPED_SIMD_TARGET_FLATTEN("avx2")
+    size_t probe_avx2(const K& key, uint64_t h, bool& found, size_t& group) const {
+        return probe_impl<AVX2Group>(key, h, found, group);
+    }
+
+    GROUPED_SIMD_TARGET_FLATTEN("avx2")
+    size_t find_free_avx2(uint64_t h, size_t& group) const {
+        return find_free_impl<AVX2Group>(h, group);
+    }
+
+    GROUPED_SIMD_TARGET_FLATTEN("avx2")
+    bool find_avx2(const K& key, uint64_t h, V& out) const {
+        return find_impl<AVX2Group>(key, h, out);
+    }
+
+    GROUPED_SIMD_TARGET_FLATTEN("avx512f,avx512bw")
+    size_t probe_avx512(const K& key, uint64_t h, bool& found, size_t& group) const {
+        return probe_impl<AVX512Group>(key, h, found, group);
+    }
+
+    GROUPED_SIMD_TARGET_FLATTEN("avx512f,avx512bw")
+    size_t find_free_avx512(uint64_t h, size_t& group) const {
+        return find_free_impl<AVX512Group>(h, group);
+    }
+
+    GROUPED_SIMD_TARGET_FLATTEN("avx512f,avx512bw")
+    bool find_avx512(const K& key, uint64_t h, V& out) const {
+        return find_impl<AVX512Group>(key, h, out);
+    }
+
+    void note_group_used(size_t g) {
+        if (g > max_group_used_.load(std::memory_order_relaxed)) {
+            max_group_used_.store(g, std::memory_order_release);
+        }
+    }
+
+    // GroupedSIMDElastic::cleanup_tombstones(), under the table-wide version
+    void cleanup_tombstones_locked() {
+        begin_write(table_version_);
+        max_group_used_.store(0, std::memory_order_relaxed);
+
+        uint8_t* meta = metadata();
+        for (size_t i = 0; i < lines_.size() * sizeof(MetadataLine); ++i) {
+            grouped_simd_detail::store_release(meta + i, (meta[i] & OCCUPIED_BIT) ? DELETED : EMPTY);
+        }
+
+        for (size_t i = 0; i < capacity_; ++i) {
+            while (meta[i] == DELETED) {
+                uint64_t h = hash_with_salt(table_[i].key);
+                size_t grp = 0;
+                size_t target = find_free(h, grp);
+                note_group_used(grp);
+
+                if (target == i) {
+                    set_metadata(i, grouped_simd_detail::make_metadata(h));
+                } else if (meta[target] == EMPTY) {
+                    table_[target] = table_[i];
+                    set_metadata(target, grouped_simd_detail::make_metadata(h));
+                    set_metadata(i, EMPTY);
+                } else {
+                    std::swap(table_[i], table_[target]);
+                    set_metadata(target, grouped_simd_detail::make_metadata(h));
+                }
+            }
+        }
+
+        tombstones_ = 0;
+        end_write(table_version_);
+    }
+
+public:
+    // Same parameters as GroupedSIMDElastic; capacity is final and inserts
+    // past the 1 - delta load limit throw std::length_error
+    explicit SeqlockGroupedSIMD(size_t capacity, double delta = 0.1, bool power_of_two = false,
+                                GroupBackend backend = GroupBackend::Auto)
+    {
+        if (capacity == 0) throw std::invalid_argument("Capacity must be positive");
+        if (delta <= 0 || delta >= 1) throw std::invalid_argument("Delta must be in (0,1)");
+
+        if (backend == GroupBackend::Auto) backend = grouped_simd_detail::best_backend();
+        if (!grouped_simd_detail::cpu_supports(backend)) {
+            throw std::invalid_argument("Group backend not supported by this CPU");
+        }
+        backend_ = backend;
+        group_size_ = backend == GroupBackend::AVX512 ? AVX512Group::WIDTH
+                    : backend == GroupBackend::AVX2 ? AVX2Group::WIDTH
+                    : backend == GroupBackend::SWAR ? SWARGroup::WIDTH
+                    : SSE2Group::WIDTH;
+
+        // Whole blocks only (see top of file); powers of two >= 64 already are
+        capacity = (capacity + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+        if (power_of_two) {
+            size_t rounded = MAX_GROUP_SIZE;
+            while (rounded < capacity) rounded <<= 1;
+            capacity = rounded;
+        }
+
+        capacity_ = capacity;
+        mask_ = power_of_two ? capacity - 1 : 0;
+        lines_.assign((capacity + MIRROR_SIZE + sizeof(MetadataLine) - 1) / sizeof(MetadataLine), MetadataLine{});
+        table_.resize(capacity);
+        versions_.reset(new std::atomic<uint32_t>[capacity / BLOCK_SIZE]());
+        max_inserts_ = capacity - static_cast<size_t>(delta * capacity);
+
+        size_t recommended = static_cast<size_t>(C * std::log2(1.0 / delta) * 4) + 8;
+        size_t max_possible = (capacity + group_size_ - 1) / group_size_;
+        total_groups_ = recommended < max_possible ? recommended : max_possible;
+
+        std::random_device rd;
+        salt_ = rd();
+    }
+
+    // Insert or update. Reuses tombstones but never cleans them up: that
+    // pauses readers, so it is left to cleanup_tombstones()
+    bool insert(const K& key, const V& value) {
+        std::lock_guard<std::mutex> guard(writer_lock_);
+        uint64_t h = hash_with_salt(key);
+
+        bool found;
+        size_t grp;
+        size_t idx = probe(key, h, found, grp);
+        if (!found && (idx == NOT_FOUND || size_.load(std::memory_order_relaxed) >= max_inserts_)) {
+            throw std::length_error("SeqlockGroupedSIMD: table is full");
+        }
+
+        std::atomic<uint32_t>& version = versions_[idx / BLOCK_SIZE];
+        begin_write(version);
+        if (found) {
+            table_[idx].value = value;
+        } else {
+            if (metadata()[idx] == DELETED) --tombstones_;
+            table_[idx] = Entry{key, value};
+            note_group_used(grp);
+            set_metadata(idx, grouped_simd_detail::make_metadata(h));
+            size_.fetch_add(1, std::memory_order_relaxed);
+        }
+        end_write(version);
+        return true;
+    }
+
+    // Remove key, leaving a DELETED tombstone. Returns false if key was absent.
+    bool erase(const K& key) {
+        std::lock_guard<std::mutex> guard(writer_lock_);
+        bool found;
+        size_t grp;
+        size_t idx = probe(key, hash_with_salt(key), found, grp);
+        if (!found) return false;
+
+        std::atomic<uint32_t>& version = versions_[idx / BLOCK_SIZE];
+        begin_write(version);
+        set_metadata(idx, DELETED);
+        end_write(version);
+        ++tombstones_;
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Copy key's value into out; false, with out untouched, if absent. Takes
+    // no lock: it retries a group a writer is changing at that moment, and
+    // waits only while a cleanup_tombstones() call is running.
+    bool find(const K& key, V& out) const {
+        uint64_t h = hash_with_salt(key);
+        for (;;) {
+            uint32_t tv = table_version_.load(std::memory_order_acquire);
+            if (tv & 1) {
+                grouped_simd_detail::cpu_relax();
+                continue;
+            }
+
+            // A cleanup may have moved entries under the lookup: only a hit
+            // that outlives the table-wide check reaches out
+            V value;
+            bool hit;
+            switch (backend_) {
+            case GroupBackend::AVX512: hit = find_avx512(key, h, value); break;
+            case GroupBackend::AVX2: hit = find_avx2(key, h, value); break;
+            case GroupBackend::SWAR: hit = find_impl<SWARGroup>(key, h, value); break;
+            default: hit = find_impl<SSE2Group>(key, h, value); break;
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (table_version_.load(std::memory_order_relaxed) == tv) {
+                if (hit) out = value;
+                return hit;
+            }
+        }
+    }
+
+    bool contains(const K& key) const {
+        V unused;
+        return find(key, unused);
+    }
+
+    // Rehash in place to drop every tombstone. O(capacity), and every find()
+    // waits until it is done: call it when readers can afford the pause,
+    // e.g. once tombstones() is a sizable fraction of capacity().
+    void cleanup_tombstones() {
+        std::lock_guard<std::mutex> guard(writer_lock_);
+        cleanup_tombstones_locked();
+    }
+
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+    size_t tombstones() const {
+        std::lock_guard<std::mutex> guard(writer_lock_);
+        return tombstones_;
+    }
+
+    size_t capacity() const { return capacity_; }
+    size_t max_group_used() const { return max_group_used_.load(std::memory_order_relaxed); }
+    GroupBackend backend() const { return backend_; }
+    size_t group_size() const { return group_size_; }
+};
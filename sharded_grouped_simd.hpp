@@ -0,0 +1,135 @@
+/**
+ * Sharded Grouped SIMD Hash Table
+ * ===============================
+ *
+ * Thread-safe wrapper: N independent GroupedSIMDElastic shards, each behind
+ * its own reader/writer lock.
+ *
+ * - Shard = top bits of a mixed hash of the key, so the shard choice is
+ *   independent of the probe position and fragment inside the shard
+ * - Lookups take the shard lock shared and use the const find(), which never
+ *   migrates, so readers of one shard run in parallel
+ * - Writers lock one shard exclusively; the other N-1 stay available
+ * - Each lock sits on its own cache line, so neighbouring shards do not
+ *   false-share
+ *
+ * Values are copied out under the lock: a pointer into a shard would be
+ * invalidated by the next writer.
+ */
+
+#pragma once
+
+#include "grouped_simd_elastic.hpp"
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class ShardedGroupedSIMD {
+public:
+    using Table = GroupedSIMDElastic<K, V, Hash, KeyEqual>;
+
+private:
+    struct alignas(64) Shard {
+        mutable std::shared_mutex lock;
+        Table table;
+
+        Shard(size_t capacity, double delta, bool power_of_two, GroupBackend backend)
+            : table(capacity, delta, power_of_two, backend) {}
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    size_t shard_count_;
+    unsigned shard_shift_;  // 64 - log2(shard_count_)
+    Hash hasher_;
+
+    // Different multiplier from the tables' own mixer
+    static constexpr uint64_t SHARD_MULTIPLIER = 0xD6E8FEB86659FD93ULL;
+
+    Shard& shard_for(const K& key) const {
+        uint64_t h = grouped_simd_detail::mix(static_cast<uint64_t>(hasher_(key)), SHARD_MULTIPLIER);
+        size_t idx = shard_shift_ == 64 ? 0 : static_cast<size_t>(h >> shard_shift_);
+        return *shards_[idx];
+    }
+
+public:
+    // capacity is the total expected size, split evenly across shards.
+    // shards is rounded up to a power of two; a few per core keeps writers
+    // from colliding.
+    explicit ShardedGroupedSIMD(size_t capacity, size_t shards = 64, double delta = 0.1,
+                                bool power_of_two = false, GroupBackend backend = GroupBackend::Auto)
+    {
+        if (shards == 0) throw std::invalid_argument("Shard count must be positive");
+
+        shard_count_ = 1;
+        unsigned bits = 0;
+        while (shard_count_ < shards) { shard_count_ <<= 1; ++bits; }
+        shard_shift_ = 64 - bits;
+
+        size_t per_shard = (capacity + shard_count_ - 1) / shard_count_;
+        shards_.reserve(shard_count_);
+        for (size_t i = 0; i < shard_count_; ++i) {
+            shards_.push_back(std::make_unique<Shard>(per_shard, delta, power_of_two, backend));
+        }
+    }
+
+    // Insert or update
+    bool insert(const K& key, const V& value) {
+        Shard& s = shard_for(key);
+        std::unique_lock<std::shared_mutex> guard(s.lock);
+        return s.table.insert(key, value);
+    }
+
+    // Insert V(args...) if key is absent; true if inserted
+    template <typename... Args>
+    bool try_emplace(const K& key, Args&&... args) {
+        Shard& s = shard_for(key);
+        std::unique_lock<std::shared_mutex> guard(s.lock);
+        return s.table.try_emplace(key, std::forward<Args>(args)...).second;
+    }
+
+    // Copy the value for key into out; false if absent
+    bool find(const K& key, V& out) const {
+        const Shard& s = shard_for(key);
+        std::shared_lock<std::shared_mutex> guard(s.lock);
+        const V* v = static_cast<const Table&>(s.table).find(key);
+        if (!v) return false;
+        out = *v;
+        return true;
+    }
+
+    bool contains(const K& key) const {
+        const Shard& s = shard_for(key);
+        std::shared_lock<std::shared_mutex> guard(s.lock);
+        return s.table.contains(key);
+    }
+
+    // Run f(V&) on the value for key (default-constructed first if absent)
+    // under the shard's exclusive lock, e.g. for counters
+    template <typename F>
+    void update(const K& key, F&& f) {
+        Shard& s = shard_for(key);
+        std::unique_lock<std::shared_mutex> guard(s.lock);
+        f(s.table[key]);
+    }
+
+    bool erase(const K& key) {
+        Shard& s = shard_for(key);
+        std::unique_lock<std::shared_mutex> guard(s.lock);
+        return s.table.erase(key);
+    }
+
+    // Sum over shards, each read under its lock; not a snapshot while writers run
+    size_t size() const {
+        size_t total = 0;
+        for (size_t i = 0; i < shard_count_; ++i) {
+            std::shared_lock<std::shared_mutex> guard(shards_[i]->lock);
+            total += shards_[i]->table.size();
+        }
+        return total;
+    }
+
+    size_t shard_count() const { return shard_count_; }
+};